@@ -0,0 +1,9 @@
+// SPDX-License-Identifier: GPLv2
+//
+// dtmf.c
+//
+// Copyright (c) 2026 agent <agent@local>
+//
+// plugin needs -fPIC version of detection code
+//
+#include "../src/dtmf.c"
@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: GPLv2
+//
+// pcm_dtmf.c
+//
+// Copyright (c) 2026 agent <agent@local>
+//
+#include <fcntl.h>
+#include <unistd.h>
+#include <alsa/asoundlib.h>
+#include <alsa/pcm_external.h>
+#include "param.h"
+
+//=================================================
+//
+//
+//		defines
+//
+//
+//=================================================
+//
+// ALSA extplug which decodes DTMF on the fly
+//
+//	app -> [dtmf] -> slave
+//	         |
+//	         +-> log / FIFO
+//
+// Audio is passed through to slave untouched. Each period is fed
+// to dtmf_stream_feed() of each channel, and decided number is
+// written to log when dtmf_decoder pushed it.
+// No allocation, and only bounded work (= period size) on transfer.
+//
+//	0.300 12
+//	0.900 34
+//
+struct dtmf_plug {
+	snd_pcm_extplug_t	ext;
+
+	struct dtmf_stream	st[MAX_CHAN];
+	struct dtmf_decoder	dec;
+	char			out[MAX_CHAN + 2];	// "," + chan
+	char			col[MAX_CHAN];
+	unsigned long		window;		// pushed challenge
+	int			width;
+	int			init;
+
+	int			fd;
+};
+
+//=======================================
+//
+// dtmf_plug_emit
+//
+// write each number as 1 line without ",", and reset it.
+//
+//=======================================
+static void dtmf_plug_emit(struct dtmf_plug *plug, unsigned long window)
+{
+	unsigned long long ms = (unsigned long long)window * plug->width * 1000 / plug->ext.rate;
+	char line[64];
+	int len;
+
+	if (!plug->dec.len)
+		return;
+
+	len = snprintf(line, sizeof(line), "%llu.%03llu %s\n", ms / 1000, ms % 1000,
+		       plug->out + (plug->out[0] == ','));
+
+	// ignore error. number will be lost if FIFO was full
+	if (write(plug->fd, line, len) < 0)
+		;
+
+	plug->dec.len = 0;
+	plug->out[0]  = '\0';
+}
+
+static void dtmf_plug_finish(struct dtmf_plug *plug)
+{
+	if (!plug->init)
+		return;
+
+	// last pushed challenge
+	dtmf_decoder_finish(&plug->dec);
+	dtmf_plug_emit(plug, plug->window - 1);
+
+	plug->init = 0;
+}
+
+//=======================================
+//
+// dtmf_plug_transfer
+//
+//=======================================
+static snd_pcm_sframes_t dtmf_plug_transfer(snd_pcm_extplug_t *ext,
+					    const snd_pcm_channel_area_t *dst_areas,
+					    snd_pcm_uframes_t dst_offset,
+					    const snd_pcm_channel_area_t *src_areas,
+					    snd_pcm_uframes_t src_offset,
+					    snd_pcm_uframes_t size)
+{
+	struct dtmf_plug *plug = ext->private_data;
+	snd_pcm_uframes_t pos = 0;
+	int chan = ext->channels;
+
+	// pass through
+	snd_pcm_areas_copy(dst_areas, dst_offset, src_areas, src_offset,
+			   chan, size, SND_PCM_FORMAT_S16);
+
+	while (pos < size) {
+		int decided = 0;
+		int n = 0;
+
+		for (int i = 0; i < chan; i++) {
+			const snd_pcm_channel_area_t *area = src_areas + i;
+			const s16 *buf = (const s16 *)((const char *)area->addr +
+						       (area->first + (src_offset + pos) * area->step) / 8);
+
+			n = dtmf_stream_feed(plug->st + i, buf, size - pos,
+					     area->step / 16, plug->col + i);
+			if (plug->col[i])
+				decided++;
+		}
+		pos += n;
+
+		// all channels are filled at the same time
+		if (!decided)
+			continue;
+
+		// decoder judges prev challenge by this challenge
+		dtmf_decoder_push(&plug->dec, plug->col);
+		dtmf_plug_emit(plug, plug->window - 1);
+		plug->window++;
+	}
+
+	return size;
+}
+
+//=======================================
+//
+// dtmf_plug_init
+//
+// called on prepare. rate / channels are fixed here
+//
+//=======================================
+static int dtmf_plug_init(snd_pcm_extplug_t *ext)
+{
+	struct dtmf_plug *plug = ext->private_data;
+
+	dtmf_plug_finish(plug);
+
+	plug->width  = ext->rate / 100 * DEGREE;
+	plug->window = 0;
+
+	for (int i = 0; i < ext->channels; i++)
+		dtmf_stream_init(plug->st + i, ext->rate, plug->width);
+
+	dtmf_decoder_init(&plug->dec, ext->channels, plug->out, sizeof(plug->out));
+	plug->init = 1;
+
+	return 0;
+}
+
+static int dtmf_plug_close(snd_pcm_extplug_t *ext)
+{
+	struct dtmf_plug *plug = ext->private_data;
+
+	dtmf_plug_finish(plug);
+
+	if (plug->fd != STDERR_FILENO)
+		close(plug->fd);
+	free(plug);
+
+	return 0;
+}
+
+static const snd_pcm_extplug_callback_t dtmf_plug_callback = {
+	.transfer	= dtmf_plug_transfer,
+	.init		= dtmf_plug_init,
+	.close		= dtmf_plug_close,
+};
+
+//=======================================
+//
+// _snd_pcm_dtmf_open
+//
+// ex) ~/.asoundrc
+//
+//	pcm.dtmf {
+//		type dtmf
+//		slave.pcm "default"
+//		log "/tmp/dtmf.fifo"	# stderr if no log
+//	}
+//
+//=======================================
+SND_PCM_PLUGIN_DEFINE_FUNC(dtmf)
+{
+	snd_config_iterator_t i, next;
+	snd_config_t *slave = NULL;
+	struct dtmf_plug *plug;
+	const char *log = NULL;
+	int ret;
+
+	snd_config_for_each(i, next, conf) {
+		snd_config_t *n = snd_config_iterator_entry(i);
+		const char *id;
+
+		if (snd_config_get_id(n, &id) < 0)
+			continue;
+		if (!strcmp(id, "comment") ||
+		    !strcmp(id, "type")    ||
+		    !strcmp(id, "hint"))
+			continue;
+		if (!strcmp(id, "slave")) {
+			slave = n;
+			continue;
+		}
+		if (!strcmp(id, "log")) {
+			ret = snd_config_get_string(n, &log);
+			if (ret < 0)
+				goto err;
+			continue;
+		}
+		SNDERR("Unknown field %s", id);
+		return -EINVAL;
+	}
+
+	if (!slave) {
+		SNDERR("No slave defined for dtmf");
+		return -EINVAL;
+	}
+
+	plug = calloc(1, sizeof(*plug));
+	if (!plug)
+		return -ENOMEM;
+
+	//
+	// O_RDWR  : FIFO can be opened without reader
+	// NONBLOCK: transfer never waits reader
+	//
+	plug->fd = STDERR_FILENO;
+	if (log) {
+		plug->fd = open(log, O_RDWR | O_CREAT | O_APPEND | O_NONBLOCK, 0644);
+		if (plug->fd < 0) {
+			ret = -errno;
+			SNDERR("cannot open %s", log);
+			goto free;
+		}
+	}
+
+	plug->ext.version	= SND_PCM_EXTPLUG_VERSION;
+	plug->ext.name		= "DTMF Decode Plugin";
+	plug->ext.callback	= &dtmf_plug_callback;
+	plug->ext.private_data	= plug;
+
+	ret = snd_pcm_extplug_create(&plug->ext, name, root, slave, stream, mode);
+	if (ret < 0)
+		goto close;
+
+	// S16 only, same as wav
+	snd_pcm_extplug_set_param(&plug->ext, SND_PCM_EXTPLUG_HW_FORMAT, SND_PCM_FORMAT_S16);
+	snd_pcm_extplug_set_slave_param(&plug->ext, SND_PCM_EXTPLUG_HW_FORMAT, SND_PCM_FORMAT_S16);
+	snd_pcm_extplug_set_param_minmax(&plug->ext, SND_PCM_EXTPLUG_HW_CHANNELS, 1, MAX_CHAN);
+
+	*pcmp = plug->ext.pcm;
+
+	return 0;
+close:
+	if (plug->fd != STDERR_FILENO)
+		close(plug->fd);
+free:
+	free(plug);
+err:
+	return ret;
+}
+
+SND_PCM_PLUGIN_SYMBOL(dtmf);
@@ -0,0 +1,121 @@
+#
+# kernel.awk
+#
+# create src/kernel.c which has Goertzel kernel for each supported rate.
+#
+#	> awk -f kernel.awk common.h dtmf.c > kernel.c
+#
+# DEGREE    : from common.h
+# TONE_xxxx : from dtmf.c (same order as dtmf_fq[])
+#
+# Each kernel has constant coefficients, analyzes all tones
+# in 1 pass, and its loop has fixed trip count.
+# Calculation order is same as goertzel() in dtmf.c,
+# thus the result is same.
+#
+BEGIN {
+	# same as parse_options()
+	split("8000 11025 16000 22050 32000 44100 48000 64000 88200 96000 176400 192000", rates, " ");
+	nrate = 12;
+	pi2 = atan2(0, -1) * 2;
+	tones = 0;
+}
+
+/^#define[ \t]+DEGREE[ \t]/	{ degree = $3 }
+/^#define[ \t]+TONE_/		{ fq[tones++] = $3 }
+
+function step(off,	k)
+{
+	for (k = 0; k < tones; k++) {
+		printf("\t\tq0 = %.17g * q1_%d - q2_%d + buf[%s];\n", coeff[k], k, k, off);
+		printf("\t\tq2_%d = q1_%d;\n", k, k);
+		printf("\t\tq1_%d = q0;\n", k);
+	}
+}
+
+function kernel(rate,	width, k, omega)
+{
+	width = int(rate / 100) * degree;
+
+	for (k = 0; k < tones; k++) {
+		omega    = pi2 * fq[k] / rate;
+		sine[k]  = sin(omega);
+		cosine[k]= cos(omega);
+		coeff[k] = cosine[k] * 2;
+	}
+
+	printf("//=======================================\n");
+	printf("//\n");
+	printf("// %d Hz : width %d\n", rate, width);
+	printf("//\n");
+	printf("//=======================================\n");
+	printf("static void kernel_%d(const s16 *buf, int stride, double *level)\n", rate);
+	printf("{\n");
+	for (k = 0; k < tones; k++)
+		printf("\tdouble q1_%d = 0, q2_%d = 0;\n", k, k);
+	printf("\tdouble q0, real, imag;\n");
+	printf("\tint i;\n\n");
+
+	# unroll x2
+	printf("\tfor (i = 0; i < %d; i += 2, buf += stride * 2) {\n", width - width % 2);
+	step("0");
+	step("stride");
+	printf("\t}\n");
+	if (width % 2) {
+		printf("\t{\n");
+		step("0");
+		printf("\t}\n");
+	}
+	printf("\n");
+
+	for (k = 0; k < tones; k++) {
+		printf("\treal = (q1_%d - q2_%d * %.17g) / %.1f;\n", k, k, cosine[k], width / 2);
+		printf("\timag = (q2_%d * %.17g) / %.1f;\n", k, sine[k], width / 2);
+		printf("\tlevel[%d] = sqrt(real * real + imag * imag);\n", k);
+	}
+	printf("}\n\n");
+
+	table = table sprintf("\t{ %6d, %5d, kernel_%d },\n", rate, width, rate);
+}
+
+END {
+	if (!degree || tones != 8) {
+		print "kernel.awk: DEGREE / TONE_xxx not found" > "/dev/stderr";
+		exit 1;
+	}
+
+	printf("// SPDX-License-Identifier: GPLv2\n");
+	printf("//\n");
+	printf("// kernel.c\n");
+	printf("//\n");
+	printf("// created by script/kernel.awk. Don't edit\n");
+	printf("//\n");
+	printf("#include \"param.h\"\n\n");
+
+	for (r = 1; r <= nrate; r++)
+		kernel(rates[r]);
+
+	printf("static const struct {\n");
+	printf("\tint rate;\n");
+	printf("\tint width;\n");
+	printf("\tdtmf_kernel kernel;\n");
+	printf("} kernel_table[] = {\n");
+	printf("%s", table);
+	printf("};\n\n");
+
+	printf("//=======================================\n");
+	printf("//\n");
+	printf("// dtmf_kernel_select\n");
+	printf("//\n");
+	printf("// NULL if no kernel. use generic goertzel() in such case\n");
+	printf("//\n");
+	printf("//=======================================\n");
+	printf("dtmf_kernel dtmf_kernel_select(int rate, int width)\n");
+	printf("{\n");
+	printf("\tfor (int i = 0; i < ARRAY_SIZE(kernel_table); i++)\n");
+	printf("\t\tif (kernel_table[i].rate  == rate &&\n");
+	printf("\t\t    kernel_table[i].width == width)\n");
+	printf("\t\t\treturn kernel_table[i].kernel;\n\n");
+	printf("\treturn NULL;\n");
+	printf("}\n");
+}
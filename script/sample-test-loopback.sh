@@ -201,10 +201,10 @@ sl=""
 echo -n " - rec:"
 for ((idx=0; idx<${idx_i}; idx++))
 do
-	NUM=`${TOP}/simple_dtmf -i ${REC}${idx}-${exp[${idx}]}`
+	NUM=`${TOP}/simple_dtmf -e ${exp[${idx}]} -i ${REC}${idx}-${exp[${idx}]}`
+	[ $? -ne 0 ] && RET="NG"
 	echo -n "${sl}${NUM}"
 	sl="/"
-	[ x"${exp[${idx}]}" != x"${NUM}" ] && RET="NG"
 done
 echo " : ${RET}"
 
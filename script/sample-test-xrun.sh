@@ -0,0 +1,91 @@
+#! /bin/bash
+#===============================
+#
+# sample-test-xrun
+#
+# [usage]
+#		sample-test-xrun.sh [rpdg]
+#
+#		-r:	rate (default: 48000)
+#		-p:	xrun position in msec (default: 300)
+#		-d:	dropped samples (= overrun)
+#		-g:	gap samples (= underrun)
+#
+# It creates DTMF wav file, and injects xrun to it.
+# drop removes samples from position, gap inserts silence to position.
+# File size is kept, thus it is padded/cut at the end.
+# Then, it checks "-x" result position and length on all channels.
+#
+#	> sample-test-xrun.sh -r 48000 -p 300 -d 100
+#	drop:100 - expect:0.300000 sec, drop 2.083 ms - xrun:0.300000 sec, drop 2.083 ms/0.300000 sec, drop 2.083 ms : OK
+#
+#	> sample-test-xrun.sh -r 8000 -p 310 -g 500
+#	gap:500 - expect:0.310000 sec, gap 62.500 ms - xrun:0.310000 sec, gap 62.500 ms/0.310000 sec, gap 62.500 ms : OK
+#
+# 2026/10/19 agent <agent@local>
+#===============================
+TOP=`readlink -f "$0" | xargs dirname | xargs dirname`
+
+RATE=48000
+POS=300
+DROP=0
+GAP=0
+while getopts r:p:d:g: opt; do
+	case "$opt" in
+		r)	RATE="${OPTARG}";;
+		p)	POS="${OPTARG}";;
+		d)	DROP="${OPTARG}";;
+		g)	GAP="${OPTARG}";;
+	esac
+done
+shift $(expr $OPTIND - 1)
+
+[ ${DROP} -eq 0 ] && [ ${GAP} -eq 0 ] && echo "no -d or -g" && exit 1
+[ ${DROP} -ne 0 ] && [ ${GAP} -ne 0 ] && echo "both -d and -g" && exit 1
+
+WORK=`mktemp -d`
+trap "rm -fr ${WORK}" EXIT
+cd ${WORK}
+
+# 2ch, 1sec tone
+${TOP}/simple_dtmf -r ${RATE} -c 2 -o 19 > /dev/null || exit 1
+
+HEAD=44				# sizeof(struct wav)
+FRAME=4				# 2ch x 16bit
+SIZE=`stat -c %s 19.wav`
+SAMPLE=`expr ${RATE} \* ${POS} / 1000`
+OFS=`expr ${HEAD} + ${SAMPLE} \* ${FRAME}`
+
+if [ ${DROP} -ne 0 ]; then
+	TYPE=drop
+	NUM=${DROP}
+	N=`expr ${DROP} \* ${FRAME}`
+	(head -c ${OFS} 19.wav
+	 tail -c +`expr ${OFS} + ${N} + 1` 19.wav
+	 head -c ${N} /dev/zero) > xrun.wav
+else
+	TYPE=gap
+	NUM=${GAP}
+	N=`expr ${GAP} \* ${FRAME}`
+	(head -c ${OFS} 19.wav
+	 head -c ${N} /dev/zero
+	 tail -c +`expr ${OFS} + 1` 19.wav | head -c `expr ${SIZE} - ${OFS} - ${N}`) > xrun.wav
+fi
+
+EXP=`awk "BEGIN { printf(\"%.6f sec, ${TYPE} %.3f ms\", ${SAMPLE} / ${RATE}, ${NUM} * 1000 / ${RATE}) }"`
+
+echo -n "${TYPE}:${NUM} - expect:${EXP}"
+
+RET="OK"
+sl=""
+echo -n " - xrun:"
+for ch in 0 1
+do
+	X=`${TOP}/simple_dtmf -x -i xrun.wav | grep "ch${ch} *xrun" | cut -d ':' -f 2 | sed 's/^ //'`
+	echo -n "${sl}${X}"
+	sl="/"
+	[ x"${EXP}" != x"${X}" ] && RET="NG"
+done
+echo " : ${RET}"
+
+[ "${RET}" = "OK" ]
@@ -0,0 +1,754 @@
+// SPDX-License-Identifier: GPLv2
+//
+// batch.c
+//
+// Copyright (c) 2026 agent <agent@local>
+//
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include "param.h"
+
+//=================================================
+//
+//
+//		defines
+//
+//
+//=================================================
+//
+// batch analyze for many wav files
+//
+// Each slot has registered buffer, and each file is read into it.
+// Many slots are in flight at the same time, and the slot is handed
+// to worker thread when its read was completed.
+//
+//	main thread			worker threads
+//
+//	open, read (io_uring) ---+
+//	open, read (io_uring) ---+-> completion --> analyze
+//	open, read (io_uring) ---+		    |
+//	   ^					    |
+//	   +------------ free slot <----------------+
+//
+// Whole file is read at once. File which is bigger than slot is read
+// into allocated buffer after 1st read (= header).
+// It uses pread() if io_uring was not available.
+//
+// Result is printed in files order as "filename result".
+//
+#define BATCH_DEPTH	32		// default slots
+#define BATCH_SLOT	(1 << 20)	// slot buffer size
+
+struct batch_file {
+	char	*name;
+	int	ret;
+	int	done;
+	char	*out;
+};
+
+struct batch_slot {
+	struct batch		*batch;
+	struct batch_slot	*next;		// free/work list
+	struct batch_file	*file;
+	struct dev_param	param;		// wav info
+	int			 idx;		// registered buffer index
+	int			 fd;
+	int			 parsed;	// header was parsed
+	char			*buf;		// registered buffer
+	char			*big;		// if data was bigger than slot
+	size_t			 pos;		// read bytes
+	size_t			 total;		// header + data
+};
+
+//
+// io_uring
+//
+struct uring {
+	int fd;
+
+	unsigned *sq_head;
+	unsigned *sq_tail;
+	unsigned *sq_mask;
+	unsigned *sq_array;
+	unsigned *cq_head;
+	unsigned *cq_tail;
+	unsigned *cq_mask;
+	struct io_uring_sqe *sqe;
+	struct io_uring_cqe *cqe;
+
+	void	*sq_ptr;
+	void	*cq_ptr;
+	size_t	 sq_size;
+	size_t	 cq_size;
+	size_t	 sqe_size;
+
+	unsigned submit;	// not yet submitted
+};
+
+//
+// pread() fallback completions
+//
+struct batch_cqe {
+	struct batch_slot	*slot;
+	int			 res;
+};
+
+//
+// worker thread
+//
+// it has own profile time, merged after join
+//
+struct batch_worker {
+	struct batch		*batch;
+	pthread_t		 thread;
+	double			 time[PROF_STAGE_MAX];
+};
+
+struct batch {
+	struct dev_param	*param;
+	struct batch_file	*file;
+	struct batch_slot	*slot;
+	int			 nr;
+	int			 depth;
+	int			 threads;
+	int			 inflight;	// read requests
+
+	struct uring		 ring;
+	int			 uring;		// io_uring is used
+
+	struct batch_cqe	*cqe;		// pread() fallback
+	int			 cqe_nr;
+
+	pthread_mutex_t		 lock;
+	pthread_cond_t		 work_cond;	// work was queued
+	pthread_cond_t		 done_cond;	// work was done
+	struct batch_slot	*work_head;
+	struct batch_slot	*work_tail;
+	struct batch_slot	*free;
+	int			 stop;
+
+	long			 analyzed;	// for profile
+	long			 samples;
+	long			 bytes;
+};
+
+//=======================================
+//
+// uring_setup
+// uring_exit
+// uring_read
+// uring_enter
+//
+// raw syscall, no liburing
+//
+//=======================================
+static int uring_setup(struct uring *ring, struct batch *batch)
+{
+	struct io_uring_params p;
+	struct iovec *iov;
+	int ret;
+
+	memset(&p, 0, sizeof(p));
+
+	ring->fd = syscall(__NR_io_uring_setup, batch->depth, &p);
+	if (ring->fd < 0)
+		return -errno;
+
+	ring->sq_size	= p.sq_off.array + p.sq_entries * sizeof(unsigned);
+	ring->cq_size	= p.cq_off.cqes  + p.cq_entries * sizeof(struct io_uring_cqe);
+	ring->sqe_size	= p.sq_entries * sizeof(struct io_uring_sqe);
+
+	if (p.features & IORING_FEAT_SINGLE_MMAP) {
+		if (ring->cq_size > ring->sq_size)
+			ring->sq_size = ring->cq_size;
+		ring->cq_size = ring->sq_size;
+	}
+
+	ret = -ENOMEM;
+	ring->sq_ptr = mmap(NULL, ring->sq_size, PROT_READ | PROT_WRITE,
+			    MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+	if (ring->sq_ptr == MAP_FAILED)
+		goto err_sq;
+
+	ring->cq_ptr = ring->sq_ptr;
+	if (!(p.features & IORING_FEAT_SINGLE_MMAP)) {
+		ring->cq_ptr = mmap(NULL, ring->cq_size, PROT_READ | PROT_WRITE,
+				    MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+		if (ring->cq_ptr == MAP_FAILED)
+			goto err_cq;
+	}
+
+	ring->sqe = mmap(NULL, ring->sqe_size, PROT_READ | PROT_WRITE,
+			 MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+	if (ring->sqe == MAP_FAILED)
+		goto err_sqe;
+
+	ring->sq_head	= ring->sq_ptr + p.sq_off.head;
+	ring->sq_tail	= ring->sq_ptr + p.sq_off.tail;
+	ring->sq_mask	= ring->sq_ptr + p.sq_off.ring_mask;
+	ring->sq_array	= ring->sq_ptr + p.sq_off.array;
+	ring->cq_head	= ring->cq_ptr + p.cq_off.head;
+	ring->cq_tail	= ring->cq_ptr + p.cq_off.tail;
+	ring->cq_mask	= ring->cq_ptr + p.cq_off.ring_mask;
+	ring->cqe	= ring->cq_ptr + p.cq_off.cqes;
+	ring->submit	= 0;
+
+	//==========================
+	// register slot buffers
+	//==========================
+	iov = calloc(batch->depth, sizeof(*iov));
+	if (!iov)
+		goto err_reg;
+
+	for (int i = 0; i < batch->depth; i++) {
+		iov[i].iov_base	= batch->slot[i].buf;
+		iov[i].iov_len	= BATCH_SLOT;
+	}
+
+	ret = syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_BUFFERS,
+		      iov, batch->depth);
+	free(iov);
+	if (ret < 0) {
+		ret = -errno;
+		goto err_reg;
+	}
+
+	return 0;
+err_reg:
+	munmap(ring->sqe, ring->sqe_size);
+err_sqe:
+	if (ring->cq_ptr != ring->sq_ptr)
+		munmap(ring->cq_ptr, ring->cq_size);
+err_cq:
+	munmap(ring->sq_ptr, ring->sq_size);
+err_sq:
+	close(ring->fd);
+
+	return ret;
+}
+
+static void uring_exit(struct uring *ring)
+{
+	munmap(ring->sqe, ring->sqe_size);
+	if (ring->cq_ptr != ring->sq_ptr)
+		munmap(ring->cq_ptr, ring->cq_size);
+	munmap(ring->sq_ptr, ring->sq_size);
+	close(ring->fd);
+}
+
+static void uring_read(struct uring *ring, struct batch_slot *slot,
+		       void *buf, size_t len, size_t offset)
+{
+	unsigned tail = *ring->sq_tail;
+	unsigned idx  = tail & *ring->sq_mask;
+	struct io_uring_sqe *sqe = ring->sqe + idx;
+
+	memset(sqe, 0, sizeof(*sqe));
+
+	// registered buffer can use READ_FIXED
+	if ((char *)buf >= slot->buf &&
+	    (char *)buf <  slot->buf + BATCH_SLOT) {
+		sqe->opcode	= IORING_OP_READ_FIXED;
+		sqe->buf_index	= slot->idx;
+	} else {
+		sqe->opcode	= IORING_OP_READ;
+	}
+	sqe->fd		= slot->fd;
+	sqe->addr	= (unsigned long)buf;
+	sqe->len	= len;
+	sqe->off	= offset;
+	sqe->user_data	= (unsigned long)slot;
+
+	ring->sq_array[idx] = idx;
+	__atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+	ring->submit++;
+}
+
+static int uring_enter(struct uring *ring, int wait)
+{
+	int ret;
+
+	do {
+		ret = syscall(__NR_io_uring_enter, ring->fd, ring->submit, wait,
+			      wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret < 0)
+		return -errno;
+
+	ring->submit -= ret;
+
+	return 0;
+}
+
+//=======================================
+//
+// batch_read
+//
+// io_uring, or pread() fallback which is completed immediately
+//
+//=======================================
+static void batch_read(struct batch *batch, struct batch_slot *slot,
+		       void *buf, size_t len, size_t offset)
+{
+	batch->inflight++;
+
+	if (batch->uring) {
+		uring_read(&batch->ring, slot, buf, len, offset);
+		return;
+	}
+
+	prof_add(PROF_CALLS, 1);
+	prof_start(PROF_READ);
+	batch->cqe[batch->cqe_nr].slot	= slot;
+	batch->cqe[batch->cqe_nr].res	= pread(slot->fd, buf, len, offset);
+	prof_stop(PROF_READ);
+	if (batch->cqe[batch->cqe_nr].res < 0)
+		batch->cqe[batch->cqe_nr].res = -errno;
+	batch->cqe_nr++;
+}
+
+//=======================================
+//
+// batch_release
+// batch_finish
+//
+//=======================================
+static void batch_release(struct batch *batch, struct batch_slot *slot)
+{
+	if (slot->fd >= 0)
+		close(slot->fd);
+	free(slot->big);
+
+	slot->fd	= -1;
+	slot->big	= NULL;
+	slot->file	= NULL;
+
+	pthread_mutex_lock(&batch->lock);
+	slot->next	= batch->free;
+	batch->free	= slot;
+	pthread_cond_signal(&batch->done_cond);
+	pthread_mutex_unlock(&batch->lock);
+}
+
+static void batch_finish(struct batch *batch, struct batch_slot *slot, int ret)
+{
+	pthread_mutex_lock(&batch->lock);
+	slot->file->ret	 = ret;
+	slot->file->done = 1;
+	pthread_mutex_unlock(&batch->lock);
+
+	batch_release(batch, slot);
+}
+
+//=======================================
+//
+// batch_worker
+//
+//=======================================
+static void *batch_worker(void *data)
+{
+	struct batch_worker *worker = data;
+	struct batch *batch = worker->batch;
+	struct batch_slot *slot;
+	double t = 0;
+	char *result;
+	char *out;
+	s16 *buf;
+	int width, challenge, size;
+	int ret;
+
+	while (1) {
+		pthread_mutex_lock(&batch->lock);
+		while (!batch->work_head && !batch->stop)
+			pthread_cond_wait(&batch->work_cond, &batch->lock);
+
+		slot = batch->work_head;
+		if (!slot) {
+			pthread_mutex_unlock(&batch->lock);
+			break;
+		}
+		batch->work_head = slot->next;
+		if (!batch->work_head)
+			batch->work_tail = NULL;
+		pthread_mutex_unlock(&batch->lock);
+
+		//==========================
+		// analyze
+		//==========================
+		buf	  = slot->big ? (s16 *)slot->big : (s16 *)(slot->buf + WAV_HEADER);
+		width	  = slot->param.rate / 100 * DEGREE;
+		challenge = slot->param.length / width;
+		size	  = (challenge + 1) * (slot->param.chan + 1);
+
+		ret	= -ENOMEM;
+		result	= calloc(1, challenge * slot->param.chan + 1);
+		out	= calloc(1, size);
+		if (result && out) {
+			if (prof_mode)
+				t = prof_now();
+			dtmf_analyze_frames(dtmf_kernel_select(slot->param.rate, width),
+					    buf, slot->param.length, slot->param.rate,
+					    slot->param.chan, result);
+			if (prof_mode) {
+				worker->time[PROF_COMPUTE] += prof_now() - t;
+				t = prof_now();
+			}
+			dtmf_decode_result(result, challenge, slot->param.chan, out, size);
+			if (prof_mode)
+				worker->time[PROF_DECIDE] += prof_now() - t;
+
+			slot->file->out	= out;
+			out		= NULL;
+			ret		= 0;
+
+			pthread_mutex_lock(&batch->lock);
+			batch->analyzed	+= challenge * slot->param.chan;
+			batch->samples	+= challenge * slot->param.chan * width;
+			pthread_mutex_unlock(&batch->lock);
+		}
+		free(result);
+		free(out);
+
+		batch_finish(batch, slot, ret);
+	}
+
+	return NULL;
+}
+
+//=======================================
+//
+// batch_complete
+//
+// read was completed. it might be partial.
+//
+//	slot->buf = [header][data .......]	(total <= BATCH_SLOT)
+//	slot->buf = [header][data ...]		(total >  BATCH_SLOT)
+//	slot->big =         [data ............]
+//
+//=======================================
+static void batch_complete(struct batch *batch, struct batch_slot *slot, int res)
+{
+	size_t data;
+	char *buf;
+	int ret;
+
+	batch->inflight--;
+
+	ret = res;
+	if (res < 0)
+		goto err;
+
+	batch->bytes += res;
+	slot->pos    += res;
+
+	//==========================
+	// parse header
+	//==========================
+	if (!slot->parsed) {
+		if (slot->pos < WAV_HEADER && res)
+			goto next;
+
+		prof_start(PROF_HEADER);
+		ret = wav_parse_header(&slot->param, slot->buf, slot->pos);
+		prof_stop(PROF_HEADER);
+		if (ret)
+			goto err;
+
+		ret = -EINVAL;
+		if (slot->param.chan == 0	 ||
+		    slot->param.chan >  MAX_CHAN ||
+		    slot->param.rate / 100 * DEGREE <= 0)
+			goto err;
+
+		data = (size_t)slot->param.length * slot->param.chan * slot->param.sample;
+
+		slot->parsed	= 1;
+		slot->total	= WAV_HEADER + data;
+
+		// bigger than slot
+		if (slot->total > BATCH_SLOT) {
+			ret = -ENOMEM;
+			slot->big = malloc(data);
+			if (!slot->big)
+				goto err;
+
+			memcpy(slot->big, slot->buf + WAV_HEADER, slot->pos - WAV_HEADER);
+		}
+	}
+
+	//==========================
+	// all data was read
+	//==========================
+	if (slot->pos >= slot->total) {
+		slot->next = NULL;
+
+		pthread_mutex_lock(&batch->lock);
+		if (batch->work_tail)
+			batch->work_tail->next = slot;
+		else
+			batch->work_head = slot;
+		batch->work_tail = slot;
+		pthread_cond_signal(&batch->work_cond);
+		pthread_mutex_unlock(&batch->lock);
+		return;
+	}
+
+	// EOF before all data
+	ret = -EIO;
+	if (!res)
+		goto err;
+next:
+	//==========================
+	// read remaining
+	//==========================
+	if (slot->big)
+		buf = slot->big + (slot->pos - WAV_HEADER);
+	else
+		buf = slot->buf + slot->pos;
+
+	batch_read(batch, slot, buf,
+		   (slot->parsed ? slot->total : BATCH_SLOT) - slot->pos,
+		   slot->pos);
+	return;
+err:
+	batch_finish(batch, slot, ret);
+}
+
+//=======================================
+//
+// batch_print
+//
+// print result in files order
+//
+//=======================================
+static int batch_print(struct batch *batch, int printed)
+{
+	struct batch_file *file;
+
+	pthread_mutex_lock(&batch->lock);
+	for (; printed < batch->nr && batch->file[printed].done; printed++) {
+		file = batch->file + printed;
+
+		if (file->ret < 0)
+			printf("%s %s\n", file->name, strerror(-file->ret));
+		else
+			printf("%s %s\n", file->name, file->out);
+
+		free(file->out);
+		file->out = NULL;
+	}
+	pthread_mutex_unlock(&batch->lock);
+
+	return printed;
+}
+
+//=======================================
+//
+// batch_run
+//
+//=======================================
+static int batch_run(struct batch *batch)
+{
+	struct batch_slot *slot;
+	int next = 0;
+	int printed = 0;
+	int ret;
+
+	while (1) {
+		//==========================
+		// start new files on free slots
+		//==========================
+		while (next < batch->nr) {
+			pthread_mutex_lock(&batch->lock);
+			slot = batch->free;
+			if (slot)
+				batch->free = slot->next;
+			pthread_mutex_unlock(&batch->lock);
+			if (!slot)
+				break;
+
+			slot->file	= batch->file + next++;
+			slot->parsed	= 0;
+			slot->pos	= 0;
+			slot->total	= 0;
+
+			prof_add(PROF_CALLS, 1);
+			slot->fd = open(slot->file->name, O_RDONLY);
+			if (slot->fd < 0) {
+				batch_finish(batch, slot, -errno);
+				continue;
+			}
+
+			batch_read(batch, slot, slot->buf, BATCH_SLOT, 0);
+		}
+
+		printed = batch_print(batch, printed);
+		if (printed == batch->nr)
+			break;
+
+		//==========================
+		// wait completion
+		//==========================
+		if (batch->uring && batch->inflight) {
+			struct uring *ring = &batch->ring;
+			unsigned head, tail;
+
+			// read time is waiting time of completion
+			prof_add(PROF_CALLS, 1);
+			prof_start(PROF_READ);
+			ret = uring_enter(ring, 1);
+			prof_stop(PROF_READ);
+			if (ret < 0)
+				return ret;
+
+			head = *ring->cq_head;
+			tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+			for (; head != tail; head++) {
+				struct io_uring_cqe *cqe = ring->cqe + (head & *ring->cq_mask);
+				struct batch_slot *done = (struct batch_slot *)(unsigned long)cqe->user_data;
+				int res = cqe->res;
+
+				// batch_complete() might queue new sqe, but
+				// cq is not overflowed, because slot has only 1 request
+				__atomic_store_n(ring->cq_head, head + 1, __ATOMIC_RELEASE);
+				batch_complete(batch, done, res);
+			}
+			continue;
+		}
+
+		if (batch->cqe_nr) {
+			struct batch_cqe cqe = batch->cqe[--batch->cqe_nr];
+
+			batch_complete(batch, cqe.slot, cqe.res);
+			continue;
+		}
+
+		// all slots are in workers
+		pthread_mutex_lock(&batch->lock);
+		while (!(batch->free && next < batch->nr) && !batch->file[printed].done)
+			pthread_cond_wait(&batch->done_cond, &batch->lock);
+		pthread_mutex_unlock(&batch->lock);
+	}
+
+	return 0;
+}
+
+//=======================================
+//
+// dtmf_batch
+//
+// ex) simple_dtmf -a *.wav
+//     simple_dtmf -a64 *.wav	(64 slots)
+//
+//=======================================
+int dtmf_batch(struct dev_param *param)
+{
+	struct batch batch;
+	struct batch_worker *th = NULL;
+	int ret = -EINVAL;
+	int i, nr = 0;
+
+	memset(&batch, 0, sizeof(batch));
+	batch.param	= param;
+	batch.nr	= param->files_nr;
+	batch.depth	= param->batch ? atoi(param->batch) : BATCH_DEPTH;
+	batch.threads	= sysconf(_SC_NPROCESSORS_ONLN);
+
+	if (batch.depth <= 0)
+		goto err;
+
+	ret = -ENOMEM;
+	batch.file = calloc(batch.nr,    sizeof(*batch.file));
+	batch.slot = calloc(batch.depth, sizeof(*batch.slot));
+	batch.cqe  = calloc(batch.depth, sizeof(*batch.cqe));
+	th	   = calloc(batch.threads, sizeof(*th));
+	if (!batch.file || !batch.slot || !batch.cqe || !th)
+		goto free;
+
+	for (i = 0; i < batch.nr; i++)
+		batch.file[i].name = param->files[i];
+
+	for (i = 0; i < batch.depth; i++) {
+		struct batch_slot *slot = batch.slot + i;
+
+		slot->buf = aligned_alloc(4096, BATCH_SLOT);
+		if (!slot->buf)
+			goto free;
+
+		slot->batch	= &batch;
+		slot->idx	= i;
+		slot->fd	= -1;
+		slot->next	= batch.free;
+		batch.free	= slot;
+	}
+
+	// fallback to pread() if io_uring was not available
+	batch.uring = !uring_setup(&batch.ring, &batch);
+
+	if (param->flag & FLAG_VERBOSE)
+		printf("io      : %s (%d slots, %d threads)\n",
+		       batch.uring ? "io_uring" : "pread", batch.depth, batch.threads);
+
+	pthread_mutex_init(&batch.lock, NULL);
+	pthread_cond_init(&batch.work_cond, NULL);
+	pthread_cond_init(&batch.done_cond, NULL);
+
+	for (nr = 0; nr < batch.threads; nr++) {
+		th[nr].batch = &batch;
+		if (pthread_create(&th[nr].thread, NULL, batch_worker, th + nr))
+			break;
+	}
+
+	ret = -ENOMEM;
+	if (nr)
+		ret = batch_run(&batch);
+
+	pthread_mutex_lock(&batch.lock);
+	batch.stop = 1;
+	pthread_cond_broadcast(&batch.work_cond);
+	pthread_mutex_unlock(&batch.lock);
+
+	// compute/decide is total of all workers
+	for (i = 0; i < nr; i++) {
+		pthread_join(th[i].thread, NULL);
+
+		prof_add_time(PROF_COMPUTE, th[i].time[PROF_COMPUTE]);
+		prof_add_time(PROF_DECIDE,  th[i].time[PROF_DECIDE]);
+	}
+
+	pthread_cond_destroy(&batch.done_cond);
+	pthread_cond_destroy(&batch.work_cond);
+	pthread_mutex_destroy(&batch.lock);
+
+	if (batch.uring)
+		uring_exit(&batch.ring);
+
+	// 1 if some files were failed
+	if (!ret)
+		for (i = 0; i < batch.nr; i++)
+			if (batch.file[i].ret < 0)
+				ret = 1;
+
+	prof_add(PROF_BYTES,	batch.bytes);
+	prof_add(PROF_ANALYZED,	batch.analyzed);
+	prof_add(PROF_SAMPLES,	batch.samples);
+free:
+	if (batch.slot)
+		for (i = 0; i < batch.depth; i++)
+			free(batch.slot[i].buf);
+	if (batch.file)
+		for (i = 0; i < batch.nr; i++)
+			free(batch.file[i].out);
+	free(batch.file);
+	free(batch.slot);
+	free(batch.cqe);
+	free(th);
+err:
+	return ret;
+}
@@ -0,0 +1,357 @@
+// SPDX-License-Identifier: GPLv2
+//
+// bench.c
+//
+// Copyright (c) 2026 agent <agent@local>
+//
+#include <time.h>
+#include "param.h"
+
+//=================================================
+//
+//
+//		defines
+//
+//
+//=================================================
+//
+// accuracy vs cost benchmark
+//
+// It creates synthetic corpus by dtmf_fill_tone() on each
+//	rate x snr x twist x tone duration
+// and analyzes each case by all settings of
+//	window x decimation x floor x ratio
+//
+//	       <-- BENCH_MSEC -------------------->
+//	case = [noise___xxxxxxxxxx_________________]
+//	                <- dur ->
+//
+// 1 noise only case is added on each corpus point to count false positive.
+// tone duration is up to 500ms, which is longer than 100ms window.
+//
+// decimation is stride on input without anti-alias filter (= zero copy),
+// thus noise over analyze rate Nyquist is aliased.
+// samples/sec is analyzed samples (= after decimation).
+//
+#define BENCH_MSEC	1000
+#define BENCH_MARGIN	50	// tone start margin (ms)
+#define BENCH_CASES	1	// default cases on each corpus point
+
+// corpus
+static const int	bench_rate[]	= { 8000, 11025, 16000, 22050, 32000, 44100,
+					    48000, 64000, 88200, 96000, 176400, 192000 };
+static const double	bench_snr[]	= { 30, 20, 10, 6 };	// dB
+static const double	bench_twist[]	= { -6, 0, 6 };		// dB, hi vs low
+static const int	bench_dur[]	= { 40, 70, 100, 200, 500 };	// ms
+
+// settings
+static const int	bench_msec[]	= { 25, 50, 100 };	// window
+static const int	bench_decim[]	= { 0, 16000, 8000 };	// analyze rate, 0 = no decimation
+//
+// corpus tone level is ~5000 (dtmf_fill_tone()), and noise level on each
+// bin is ~5 - 600 (depends on snr and window). floor 300 cuts some noise,
+// 3000 cuts weak / partial tone. ratio 2 lets noise only case pass.
+//
+static const double	bench_floor[]	= { DTMF_FLOOR, 300, 3000 };
+static const double	bench_ratio[]	= { 2, 5, 10, DTMF_RATIO };
+
+#define BENCH_SNR_NR	ARRAY_SIZE(bench_snr)
+#define BENCH_SET_NR	(ARRAY_SIZE(bench_msec)  * ARRAY_SIZE(bench_decim) * \
+			 ARRAY_SIZE(bench_floor) * ARRAY_SIZE(bench_ratio))
+
+struct bench_set {
+	int	msec;
+	int	decim;
+	double	floor;
+	double	ratio;
+
+	long	tone;			// tone cases
+	long	detect;			// tone was detected
+	long	snr_tone[BENCH_SNR_NR];
+	long	snr_detect[BENCH_SNR_NR];
+	long	cases;
+	long	false_positive;		// other num was detected
+	long	samples;		// analyzed samples
+	double	sec;
+};
+
+//=======================================
+//
+// bench_factor
+//
+// decimation factor which is dividable for rate.
+// analyze rate will be (rate / factor)
+//
+//=======================================
+static int bench_factor(int rate, int decim)
+{
+	int factor;
+
+	if (!decim)
+		return 1;
+
+	for (factor = rate / decim; factor > 1; factor--)
+		if (!(rate % factor))
+			break;
+
+	return factor ? factor : 1;
+}
+
+//=======================================
+//
+// bench_tone
+//
+// keypad
+//	      1209 1336 1477
+//	697 :  1    2    3
+//	770 :  4    5    6
+//	852 :  7    8    9
+//	941 :       0
+//
+// dtmf_fill() is dtmf_fill_tone() of low/hi pair.
+// Each tone is created separately to apply twist.
+//
+//=======================================
+static void bench_tone(s16 *buf, s16 *tmp, int length, int rate,
+		       int num, double twist)
+{
+	double gain = pow(10, twist / 20);
+	int low = (num == 0) ? dtmf_fq[3] : dtmf_fq[(num - 1) / 3];
+	int hi  = (num == 0) ? dtmf_fq[5] : dtmf_fq[(num - 1) % 3 + 4];
+
+	dtmf_fill_tone(buf, length, rate, sizeof(s16), low, 0);
+	dtmf_fill_tone(tmp, length, rate, sizeof(s16), 0, hi);
+
+	for (int i = 0; i < length; i++) {
+		double v = buf[i] + tmp[i] * gain;
+
+		if (v >  32767) v =  32767;
+		if (v < -32768) v = -32768;
+
+		buf[i] = v;
+	}
+}
+
+//=======================================
+//
+// bench_case
+//
+// num < 0 is noise only case
+//
+//=======================================
+static void bench_case(s16 *buf, s16 *tone, s16 *tmp, int length, int rate,
+		       int num, double snr, double twist, int dur,
+		       unsigned int *state)
+{
+	int tone_len = rate * dur / 1000;
+	int margin   = rate * BENCH_MARGIN / 1000;
+	int pos      = margin + sim_rand(state) % (length - tone_len - margin * 2);
+	double power = 0;
+	double sigma;
+
+	// noise level is based on tone power even though it is noise only case
+	bench_tone(tone, tmp, tone_len, rate, (num < 0) ? 1 : num, twist);
+	for (int i = 0; i < tone_len; i++)
+		power += (double)tone[i] * tone[i];
+	sigma = sqrt(power / tone_len / pow(10, snr / 10));
+
+	for (int i = 0; i < length; i++) {
+		double v = sim_gauss(state) * sigma;
+
+		if (num >= 0 && i >= pos && i < pos + tone_len)
+			v += tone[i - pos];
+
+		if (v >  32767) v =  32767;
+		if (v < -32768) v = -32768;
+
+		buf[i] = v;
+	}
+}
+
+//=======================================
+//
+// bench_analyze
+//
+// analyze by setting, and check the result
+//
+//=======================================
+static void bench_analyze(struct bench_set *set, s16 *buf, int length, int rate,
+			  int num, int snr, char *out, int size)
+{
+	struct dtmf_decoder dec;
+	struct dtmf_level lv;
+	struct timespec start, end;
+	int factor	= bench_factor(rate, set->decim);
+	int width	= (rate / factor) * set->msec / 1000;
+	int step	= width * factor;	// input samples of 1 window
+	int challenge	= length / step;
+	int detect	= 0;
+	int other	= 0;
+
+	dtmf_floor = set->floor;
+	dtmf_ratio = set->ratio;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	dtmf_decoder_init(&dec, 1, out, size);
+	for (int j = 0; j < challenge; j++) {
+		struct dtmf_data data = {
+			.buf	= { buf + step * j },
+			.length	= { width },
+			.stride	= factor,
+		};
+		char col = dtmf_analyze_data(&data, rate / factor, &lv);
+
+		dtmf_decoder_push(&dec, &col);
+	}
+	dtmf_decoder_finish(&dec);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	set->sec     += (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1000000000.0;
+	set->samples += challenge * width;
+
+	for (int i = 0; out[i]; i++) {
+		if (out[i] == '0' + num)
+			detect = 1;
+		else if (out[i] >= '0' && out[i] <= '9')
+			other = 1;
+	}
+
+	set->cases++;
+	set->false_positive += other;
+	if (num < 0)
+		return;
+
+	set->tone++;
+	set->detect += detect;
+	set->snr_tone[snr]++;
+	set->snr_detect[snr] += detect;
+}
+
+//=======================================
+//
+// bench_print
+//
+//=======================================
+static void bench_print(struct dev_param *param, struct bench_set *set)
+{
+	int i, s;
+
+	printf("window stride floor ratio :  detect   false   samples/sec");
+	if (param->flag & FLAG_VERBOSE)
+		for (s = 0; s < BENCH_SNR_NR; s++)
+			printf("  %2.0fdB", bench_snr[s]);
+	printf("\n");
+
+	for (i = 0; i < BENCH_SET_NR; i++, set++) {
+		char decim[16] = "-";
+
+		if (set->decim)
+			snprintf(decim, sizeof(decim), "%d", set->decim);
+
+		printf("%4dms %6s %6.1f %5.0f : %6.2f%% %6.2f%% %13.0f",
+		       set->msec, decim, set->floor, set->ratio,
+		       100.0 * set->detect / set->tone,
+		       100.0 * set->false_positive / set->cases,
+		       set->sec ? set->samples / set->sec : 0);
+
+		if (param->flag & FLAG_VERBOSE)
+			for (s = 0; s < BENCH_SNR_NR; s++)
+				printf(" %5.1f%%", 100.0 * set->snr_detect[s] / set->snr_tone[s]);
+
+		// current setting
+		if (set->msec  == 10 * DEGREE	&&
+		    set->decim == 0		&&
+		    set->floor == DTMF_FLOOR	&&
+		    set->ratio == DTMF_RATIO)
+			printf(" *");
+		printf("\n");
+	}
+}
+
+//=======================================
+//
+// dtmf_bench
+//
+// ex) simple_dtmf -B
+//     simple_dtmf -B4	(4 cases on each corpus point)
+//
+//=======================================
+int dtmf_bench(struct dev_param *param)
+{
+	struct bench_set *set;
+	unsigned int state = 1;
+	int cases = param->bench ? atoi(param->bench) : BENCH_CASES;
+	int length = bench_rate[ARRAY_SIZE(bench_rate) - 1] * BENCH_MSEC / 1000;
+	int size = length + 2;	// enough for out
+	s16 *buf, *tone, *tmp;
+	char *out;
+	int ret = -EINVAL;
+	int i, r, s, t, d, c;
+
+	if (cases <= 0)
+		goto err;
+
+	ret = -ENOMEM;
+	set  = calloc(BENCH_SET_NR, sizeof(*set));
+	buf  = calloc(length, sizeof(s16));
+	tone = calloc(length, sizeof(s16));
+	tmp  = calloc(length, sizeof(s16));
+	out  = calloc(size, 1);
+	if (!set || !buf || !tone || !tmp || !out)
+		goto free;
+
+	// fill settings
+	i = 0;
+	for (int a = 0; a < ARRAY_SIZE(bench_msec); a++)
+	for (int b = 0; b < ARRAY_SIZE(bench_decim); b++)
+	for (int f = 0; f < ARRAY_SIZE(bench_floor); f++)
+	for (int q = 0; q < ARRAY_SIZE(bench_ratio); q++, i++) {
+		set[i].msec	= bench_msec[a];
+		set[i].decim	= bench_decim[b];
+		set[i].floor	= bench_floor[f];
+		set[i].ratio	= bench_ratio[q];
+	}
+
+	//==========================
+	// create each case, and analyze it by all settings
+	//==========================
+	for (r = 0; r < ARRAY_SIZE(bench_rate); r++) {
+		int rate = bench_rate[r];
+		int len  = rate * BENCH_MSEC / 1000;
+
+		for (s = 0; s < ARRAY_SIZE(bench_snr);   s++)
+		for (t = 0; t < ARRAY_SIZE(bench_twist); t++)
+		for (d = 0; d < ARRAY_SIZE(bench_dur);   d++)
+		for (c = -1; c < cases; c++) {
+			// c = -1 is noise only case
+			int num = (c < 0) ? -1 : sim_rand(&state) % 10;
+
+			bench_case(buf, tone, tmp, len, rate, num,
+				   bench_snr[s], bench_twist[t], bench_dur[d], &state);
+
+			for (i = 0; i < BENCH_SET_NR; i++)
+				bench_analyze(set + i, buf, len, rate, num, s, out, size);
+		}
+	}
+
+	printf("corpus  : %zu rates, %zu snr, %zu twist, %zu duration, %d+1 cases\n",
+	       ARRAY_SIZE(bench_rate), ARRAY_SIZE(bench_snr),
+	       ARRAY_SIZE(bench_twist), ARRAY_SIZE(bench_dur), cases);
+	bench_print(param, set);
+
+	// success
+	ret = 0;
+free:
+	dtmf_floor = DTMF_FLOOR;
+	dtmf_ratio = DTMF_RATIO;
+
+	free(set);
+	free(buf);
+	free(tone);
+	free(tmp);
+	free(out);
+err:
+	return ret;
+}
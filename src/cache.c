@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: GPLv2
+//
+// cache.c
+//
+// Copyright (c) 2026 agent <agent@local>
+//
+#include <dirent.h>
+#include <unistd.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include "param.h"
+
+//=================================================
+//
+//
+//		defines
+//
+//
+//=================================================
+//
+// analyze result cache
+//
+// key  = hash of wav data + analyze params
+// file = <dir>/<key> which has decoded string
+//
+// It keeps CACHE_MAX files, and removes least recently used ones.
+// The hit file is touched to update its mtime.
+//
+#define CACHE_MAX	4096
+#define CACHE_VERSION	1
+#define CACHE_NAME	17	// 16 hex + '\0'
+#define CACHE_PATH	1024
+
+struct cache_entry {
+	time_t mtime;
+	char name[CACHE_NAME];
+};
+
+//=======================================
+//
+// cache_key
+//
+// it adds analyze params to the wav data hash
+//
+//=======================================
+u64 cache_key(struct hash *h, struct dev_param *param)
+{
+	struct {
+		int version;
+		int rate;
+		int chan;
+		int sample;
+		int length;
+		int degree;
+		double floor;
+		double ratio;
+	} key = {
+		.version	= CACHE_VERSION,
+		.rate		= param->rate,
+		.chan		= param->chan,
+		.sample		= param->sample,
+		.length		= param->length,
+		.degree		= DEGREE,
+		.floor		= dtmf_floor,
+		.ratio		= dtmf_ratio,
+	};
+
+	hash_update(h, &key, sizeof(key));
+
+	return hash_final(h);
+}
+
+static void cache_path(struct dev_param *param, u64 key, char *path)
+{
+	snprintf(path, CACHE_PATH, "%s/%016llx", param->cache, key);
+}
+
+//=======================================
+//
+// cache_lookup
+//
+// return 0 if hit
+//
+//=======================================
+int cache_lookup(struct dev_param *param, u64 key, char *out, int size)
+{
+	char path[CACHE_PATH];
+	FILE *fp;
+	int ret = -ENOENT;
+	int len;
+
+	cache_path(param, key, path);
+
+	fp = fopen(path, "r");
+	if (!fp)
+		goto err;
+
+	if (!fgets(out, size, fp))
+		goto close;
+
+	len = strlen(out);
+	if (len && out[len - 1] == '\n')
+		out[len - 1] = '\0';
+
+	// LRU
+	utime(path, NULL);
+
+	ret = 0;
+close:
+	fclose(fp);
+err:
+	return ret;
+}
+
+//=======================================
+//
+// cache_evict
+//
+//=======================================
+static int cache_cmp(const void *a, const void *b)
+{
+	const struct cache_entry *ea = a;
+	const struct cache_entry *eb = b;
+
+	return (ea->mtime > eb->mtime) - (ea->mtime < eb->mtime);
+}
+
+static void cache_evict(struct dev_param *param)
+{
+	struct cache_entry *entry = NULL;
+	struct dirent *d;
+	struct stat st;
+	char path[CACHE_PATH];
+	DIR *dir;
+	int nr = 0;
+	int max = 0;
+
+	dir = opendir(param->cache);
+	if (!dir)
+		return;
+
+	while ((d = readdir(dir))) {
+		if (strlen(d->d_name) != CACHE_NAME - 1 ||
+		    strspn(d->d_name, "0123456789abcdef") != CACHE_NAME - 1)
+			continue;
+
+		snprintf(path, CACHE_PATH, "%s/%s", param->cache, d->d_name);
+		if (stat(path, &st) < 0)
+			continue;
+
+		if (nr == max) {
+			struct cache_entry *e;
+
+			max = max ? max * 2 : 256;
+			e = realloc(entry, max * sizeof(*entry));
+			if (!e)
+				goto err;
+			entry = e;
+		}
+
+		entry[nr].mtime = st.st_mtime;
+		strcpy(entry[nr].name, d->d_name);
+		nr++;
+	}
+
+	if (nr <= CACHE_MAX)
+		goto err;
+
+	// remove older files
+	qsort(entry, nr, sizeof(*entry), cache_cmp);
+	for (int i = 0; i < nr - CACHE_MAX; i++) {
+		snprintf(path, CACHE_PATH, "%s/%s", param->cache, entry[i].name);
+		unlink(path);
+	}
+err:
+	free(entry);
+	closedir(dir);
+}
+
+//=======================================
+//
+// cache_store
+//
+// write to tmp file, and rename it to avoid broken cache
+//
+//=======================================
+void cache_store(struct dev_param *param, u64 key, const char *out)
+{
+	char path[CACHE_PATH];
+	char tmp[CACHE_PATH + 16];	// path + "." + pid
+	FILE *fp;
+
+	mkdir(param->cache, 0755);
+
+	cache_path(param, key, path);
+	snprintf(tmp, sizeof(tmp), "%s.%d", path, getpid());
+
+	fp = fopen(tmp, "w");
+	if (!fp)
+		return;
+
+	fprintf(fp, "%s\n", out);
+
+	if (fclose(fp) || rename(tmp, path)) {
+		unlink(tmp);
+		return;
+	}
+
+	cache_evict(param);
+}
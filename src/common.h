@@ -8,6 +8,7 @@
 #define __COMMON_H
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 #include <string.h>
 #include <errno.h>
@@ -16,7 +17,151 @@
 
 #define u16	unsigned short
 #define u32	unsigned int
+#define u64	unsigned long long
 
 const static char unknown = '?';
 
+#define MAX_CHAN	16
+
+#define PI2		(M_PI * 2)
+
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
+
+//
+// analyze window (= challenge) size
+//
+//	width = rate / 100 * DEGREE
+//
+#define DEGREE		10	// 10%
+
+//
+// dtmf_analyze_level() result
+//
+// level[] : Goertzel level of each dtmf_fq[]
+//	     [0-3] : low  tone (697,  770,  852,  941)
+//	     [4-7] : hi   tone (1209, 1336, 1477, 1633)
+// low/hi  : selected tone frequency, or -1
+//
+#define DTMF_LEVELS	8
+// threshold. -B can update it via dtmf_floor/dtmf_ratio
+#define DTMF_FLOOR	0.5	// min level
+#define DTMF_RATIO	20	// selected level vs others
+struct dtmf_level {
+	double level[DTMF_LEVELS];
+	int low;
+	int hi;
+};
+
+extern const int dtmf_fq[DTMF_LEVELS];
+extern double dtmf_floor;
+extern double dtmf_ratio;
+
+//
+// rate specific Goertzel kernel (created by script/kernel.awk)
+// it fills level[] of 1 challenge
+//
+typedef void (*dtmf_kernel)(const s16 *buf, int stride, double *level);
+
+//
+// dtmf_analyze_data() data
+//
+// 1ch data which might be interleaved (= stride),
+// and/or might be wrapped (= ring buffer)
+//
+//	       buf[1]      buf[0]
+//	       v           v
+//	ring: [yyyy________xxxxxxx]
+//	       length[1]   length[0]
+//
+#define DTMF_DATA_SEG	2
+struct dtmf_data {
+	s16 *buf[DTMF_DATA_SEG];
+	int length[DTMF_DATA_SEG];
+	int stride;
+};
+
+//
+// dtmf_xrun() result
+//
+// pos  : discontinuity start sample
+// len  : discontinuity length (0 if it was phase jump)
+// drop : dropped samples which is estimated from phase jump
+//
+struct dtmf_xrun {
+	int pos;
+	int len;
+	int drop;
+};
+
+//
+// dtmf_drift_xxx() context
+//
+// 0 clear it before use
+//
+struct dtmf_drift {
+	double sxx;	// pooled sum
+	double sxy;
+
+	double st;	// current segment
+	double sp;
+	double stt;
+	double stp;
+	double unwrap;
+	double phase;
+	int t0;
+	int n;
+	int last;
+};
+
+//
+// dtmf_stream_xxx() context
+//
+// Goertzel state of all tones for streaming data
+//
+struct dtmf_stream {
+	double coeff[DTMF_LEVELS];
+	double sine[DTMF_LEVELS];
+	double cosine[DTMF_LEVELS];
+	double q1[DTMF_LEVELS];
+	double q2[DTMF_LEVELS];
+	int count;
+	int width;
+};
+
+//
+// dtmf_decoder_xxx() context
+//
+// It gets each challenge result of all channels (= col) one by one,
+// and decodes it into "out" string (ex "12,34").
+// It prints to stdout directly if "out" was NULL.
+//
+struct dtmf_decoder {
+	char prev[MAX_CHAN];
+	char pend[MAX_CHAN];	// it needs next col to judge
+	int pending;
+	int comma;
+	int chan;
+
+	char *out;
+	int size;
+	int len;
+};
+
+//
+// hash_xxx() context (XXH64 compatible)
+//
+#define HASH_STRIPE	32
+struct hash {
+	u64 v[4];
+	u64 seed;
+	u64 total;
+	unsigned char mem[HASH_STRIPE];
+	size_t size;
+};
+
+void hash_init(struct hash *h, u64 seed);
+void hash_update(struct hash *h, const void *data, size_t len);
+u64  hash_final(struct hash *h);
+u64  hash64(const void *data, size_t len, u64 seed);
+
 #endif /* __COMMON_H */
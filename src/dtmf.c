@@ -29,7 +29,6 @@ struct tone_info {
 #define TONE_369x	1477
 #define TONE_ABCD	1633
 
-#define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
 const static struct tone_info tone_info[] = {
 	{ '0', TONE_x0xD, TONE_2580 },
 	{ '1', TONE_123A, TONE_147x },
@@ -43,14 +42,13 @@ const static struct tone_info tone_info[] = {
 	{ '9', TONE_789C, TONE_369x },
 };
 
-#define PI2		(M_PI * 2)
-
 //=======================================
 //
 // goertzel
 //
 //=======================================
-static double goertzel(s16 *buf, int length, int rate, int dtmf_fq)
+static void __goertzel(struct dtmf_data *data, int rate, int dtmf_fq,
+		       double *real, double *imag)
 {
 	double omega	= PI2 * dtmf_fq / rate;
 	double sine	= sin(omega);
@@ -59,42 +57,75 @@ static double goertzel(s16 *buf, int length, int rate, int dtmf_fq)
 	double q0	= 0;
 	double q1	= 0;
 	double q2	= 0;
+	int length	= 0;
+
+	for (int s = 0; s < DTMF_DATA_SEG; s++) {
+		s16 *buf = data->buf[s];
 
-	for (int i = 0; i < length; i++) {
-		q0 = coeff * q1 - q2 + buf[i];
-		q2 = q1;
-		q1 = q0;
+		for (int i = 0; i < data->length[s]; i++, buf += data->stride) {
+			q0 = coeff * q1 - q2 + *buf;
+			q2 = q1;
+			q1 = q0;
+		}
+		length += data->length[s];
 	}
 
-	double real = (q1 - q2 * cosine) / (length / 2.0);
-	double imag = (q2 * sine)        / (length / 2.0);
+	*real = (q1 - q2 * cosine) / (length / 2.0);
+	*imag = (q2 * sine)        / (length / 2.0);
+}
+
+static double goertzel(struct dtmf_data *data, int rate, int dtmf_fq)
+{
+	double real, imag;
+
+	__goertzel(data, rate, dtmf_fq, &real, &imag);
 
 	return sqrt(real * real + imag * imag);
 }
 
+#define dtmf_data_init(data, b, l)		\
+	struct dtmf_data data = {		\
+		.buf	= { b, NULL },		\
+		.length	= { l, 0 },		\
+		.stride	= 1,			\
+	}
+
+// any frequency version for other files
+double dtmf_goertzel(s16 *buf, int length, int rate, int fq)
+{
+	dtmf_data_init(data, buf, length);
+
+	return goertzel(&data, rate, fq);
+}
+
 //=======================================
 //
 // dtmf_analyze
 //
 //=======================================
+const int dtmf_fq[DTMF_LEVELS] = {
+	TONE_123A, TONE_456B, TONE_789C, TONE_x0xD,	// low
+	TONE_147x, TONE_2580, TONE_369x, TONE_ABCD,	// hi
+};
+
+double dtmf_floor = DTMF_FLOOR;
+double dtmf_ratio = DTMF_RATIO;
+
 #define DTMF_LEVELS_MAX	4
-static void __dtmf_analyze(s16 *buf, int length, int rate, const int *fq, int *ret)
+static void __dtmf_analyze(const double *level, const int *fq, int *ret)
 {
-	double level[DTMF_LEVELS_MAX];
 	int i, idx = 0;
 
 	//==========================
 	// analyze dtmf
 	//==========================
 	for (i = 0; i < DTMF_LEVELS_MAX; i++) {
-		level[i] = goertzel(buf, length, rate, fq[i]);
-
 		// FIXME
 		if (level[idx] < level[i])
 			idx = i;
 	}
 
-	if (level[idx] < 0.5) // FIXME
+	if (level[idx] < dtmf_floor) // FIXME
 		return;
 
 	//==========================
@@ -106,7 +137,7 @@ static void __dtmf_analyze(s16 *buf, int length, int rate, const int *fq, int *r
 		if (i == idx)
 			continue;
 
-		if ((level[i] * 20) > level[idx])
+		if ((level[i] * dtmf_ratio) > level[idx])
 			return;
 	}
 
@@ -114,22 +145,24 @@ static void __dtmf_analyze(s16 *buf, int length, int rate, const int *fq, int *r
 	*ret = fq[idx];
 }
 
-char dtmf_analyze(s16 *buf, int length, int rate)
+static char dtmf_decide(struct dtmf_level *lv)
 {
-	static const int dtmf_fq_low[DTMF_LEVELS_MAX] = { TONE_123A, TONE_456B, TONE_789C, TONE_x0xD };
-	static const int dtmf_fq_hi[ DTMF_LEVELS_MAX] = { TONE_147x, TONE_2580, TONE_369x, TONE_ABCD };
-	int low = -1;
-	int hi  = -1;
+	const int *dtmf_fq_low = dtmf_fq;
+	const int *dtmf_fq_hi  = dtmf_fq + DTMF_LEVELS_MAX;
+	int i;
+
+	lv->low = -1;
+	lv->hi  = -1;
 
-	__dtmf_analyze(buf, length, rate, dtmf_fq_low, &low);
-	__dtmf_analyze(buf, length, rate, dtmf_fq_hi,  &hi);
+	__dtmf_analyze(lv->level,		    dtmf_fq_low, &lv->low);
+	__dtmf_analyze(lv->level + DTMF_LEVELS_MAX, dtmf_fq_hi,  &lv->hi);
 
-	if (low < 0 || hi < 0)
+	if (lv->low < 0 || lv->hi < 0)
 		goto err;
 
-	for (int i = 0; i < ARRAY_SIZE(tone_info); i++) {
-		if (tone_info[i].low == low &&
-		    tone_info[i].hi  == hi) {
+	for (i = 0; i < ARRAY_SIZE(tone_info); i++) {
+		if (tone_info[i].low == lv->low &&
+		    tone_info[i].hi  == lv->hi) {
 			return tone_info[i].num;
 		}
 	}
@@ -137,39 +170,808 @@ err:
 	return unknown;
 }
 
+char dtmf_analyze_data(struct dtmf_data *data, int rate, struct dtmf_level *lv)
+{
+	for (int i = 0; i < DTMF_LEVELS; i++)
+		lv->level[i] = goertzel(data, rate, dtmf_fq[i]);
+
+	return dtmf_decide(lv);
+}
+
+char dtmf_analyze_level(s16 *buf, int length, int rate, struct dtmf_level *lv)
+{
+	dtmf_data_init(data, buf, length);
+
+	return dtmf_analyze_data(&data, rate, lv);
+}
+
+//
+// kernel is from dtmf_kernel_select(), which is selected once per file.
+// use generic goertzel() if no kernel
+//
+char dtmf_analyze_kernel(dtmf_kernel kernel, s16 *buf, int length, int stride,
+			 int rate, struct dtmf_level *lv)
+{
+	struct dtmf_data data = {
+		.buf	= { buf, NULL },
+		.length	= { length, 0 },
+		.stride	= stride,
+	};
+
+	if (!kernel)
+		return dtmf_analyze_data(&data, rate, lv);
+
+	kernel(buf, stride, lv->level);
+
+	return dtmf_decide(lv);
+}
+
+char dtmf_analyze(s16 *buf, int length, int rate)
+{
+	struct dtmf_level lv;
+
+	return dtmf_analyze_level(buf, length, rate, &lv);
+}
+
 //=======================================
 //
-// dtmf_fill
+// dtmf_stream_init
+// dtmf_stream_feed
+//
+// Goertzel which can be fed by any size (ex. ALSA period).
+// It keeps state of all tones, and returns the result when
+// 1 challenge (= width) was filled. The result is same as dtmf_analyze().
+//
+//	feed  = [xxxx][xxxxxxxx][xxxxx]...
+//	width = [xxxxxxxxx][xxxxxxxxx]...
+//	                  ^         ^
+//	                  num       num
+//
+// dtmf_stream_feed() returns used samples, it might be smaller than
+// length if challenge was filled. *num is '\0' if not yet filled.
 //
 //=======================================
-int dtmf_fill(s16 *buf, int length, int rate, int sample, char num)
+void dtmf_stream_init(struct dtmf_stream *st, int rate, int width)
 {
-	long volume		= 40000000 / rate;
-	double phase_low	= 0;
-	double phase_hi		= 0;
-	double add_low;
-	double add_hi;
-	int tone_low = 0;
-	int tone_hi  = 0;
-	int i, v = 0;
+	memset(st, 0, sizeof(*st));
 
-	if (num == '_') {
-		/* do nothing */
-		memset(buf, 0, length * sample);
+	st->width = width;
+
+	for (int i = 0; i < DTMF_LEVELS; i++) {
+		double omega = PI2 * dtmf_fq[i] / rate;
+
+		st->sine[i]	= sin(omega);
+		st->cosine[i]	= cos(omega);
+		st->coeff[i]	= st->cosine[i] * 2;
+	}
+}
+
+int dtmf_stream_feed(struct dtmf_stream *st, const s16 *buf, int length, int stride, char *num)
+{
+	struct dtmf_level lv;
+	int n = st->width - st->count;
+	int i;
+
+	if (n > length)
+		n = length;
+
+	for (int k = 0; k < DTMF_LEVELS; k++) {
+		const s16 *b	= buf;
+		double coeff	= st->coeff[k];
+		double q0;
+		double q1	= st->q1[k];
+		double q2	= st->q2[k];
+
+		for (i = 0; i < n; i++, b += stride) {
+			q0 = coeff * q1 - q2 + *b;
+			q2 = q1;
+			q1 = q0;
+		}
+
+		st->q1[k] = q1;
+		st->q2[k] = q2;
+	}
+
+	st->count += n;
+	*num = '\0';
+
+	if (st->count < st->width)
+		return n;
+
+	// same as goertzel()
+	for (int k = 0; k < DTMF_LEVELS; k++) {
+		double real = (st->q1[k] - st->q2[k] * st->cosine[k]) / (st->width / 2.0);
+		double imag = (st->q2[k] * st->sine[k])              / (st->width / 2.0);
+
+		lv.level[k] = sqrt(real * real + imag * imag);
+
+		st->q1[k] = 0;
+		st->q2[k] = 0;
+	}
+	st->count = 0;
+
+	*num = dtmf_decide(&lv);
+
+	return n;
+}
+
+//=======================================
+//
+// dtmf_decoder_init
+// dtmf_decoder_push
+// dtmf_decoder_finish
+//
+// In reality, data might have some dfmfs, and some parts might be noise
+//
+// <> : challenge
+// vv : noise
+//
+//        vvvv               vvv          vvvv
+// buf = [___xxxxxx____xxxxxxxx_____xxxxxxxx__]
+//        <><><><><><><><><><><><><><><><><><>
+//
+// We keep prev "challenge" to judge either it was noise or not.
+//
+// handle each challenge and print it
+//
+// ex)
+//
+// result = [?? 11 11 22 22 ?? 33 33 3? ?9 ?? ?4 44 44 ?? 55 55 55 ??]
+//
+// print = 11 22 33 ?9 44 55
+//
+//=======================================
+static void dtmf_decoder_out(struct dtmf_decoder *dec, char c)
+{
+	// print it directly if no out (= streaming)
+	if (!dec->out) {
+		putchar(c);
+		fflush(stdout);
+		dec->len++;
+		return;
+	}
+
+	if (dec->len + 1 >= dec->size)
+		return;
+
+	dec->out[dec->len++] = c;
+	dec->out[dec->len]   = '\0';
+}
+
+//
+// next : next col, or NULL if col was last challenge
+//
+static void __dtmf_decoder(struct dtmf_decoder *dec, const char *col, const char *next)
+{
+	int same = 0;
+	int uk = 0;
+	int late_j = 0;
+	int i;
+
+	// check prev challenge, unknown
+	for (i = 0; i < dec->chan; i++) {
+		if (col[i] == dec->prev[i])
+			same++;
+		if (col[i] == unknown)
+			uk++;
+	}
+
+	//    skip if all data were same as prev data. (.. 33 33 ..)
+	// or skip if all data were unknown (noise)    (.. ?? ..)
+	if (same == dec->chan ||
+	    uk   == dec->chan)
+		return;
+
+	// ex)
+	//
+	// result ~= [11 22 33 3? ?9 ?4 44 55]
+	//
+
+	// [.. 3? .. ?9 .. ?4 ..]
+	if (uk) {
+		//        *
+		// [.. 33 3? ..]
+		// it is noise
+		if (same > 0)
+			return;
+
+		//      *
+		// [.. ?4 44 ..]
+		// it is also noise, but we can't judge it now.
+		// late judge
+
+		// finish if it was last challenge
+		if (!next)
+			return;
+
+		late_j = 1;
+	}
+
+	if (late_j) {
+		int noise = 0;
+
+		//      *
+		// [.. ?4 44 ..]     noise
+		// [.. ?9 ?4 ..] not noise
+		for (i = 0; i < dec->chan; i++)
+			if (col[i] != unknown &&
+			    col[i] == next[i])
+				noise++;
+
+		if (noise)
+			goto next;
+	}
+
+	if (dec->comma)
+		dtmf_decoder_out(dec, ',');
+
+	// print current data
+	for (i = 0; i < dec->chan; i++)
+		dtmf_decoder_out(dec, col[i]);
+
+next:	// keep prev[]
+	memcpy(dec->prev, col, dec->chan);
+
+	dec->comma = 1;
+}
+
+void dtmf_decoder_init(struct dtmf_decoder *dec, int chan, char *out, int size)
+{
+	memset(dec, 0, sizeof(*dec));
+
+	dec->chan = chan;
+	dec->out  = out;
+	dec->size = size;
+
+	if (out && size > 0)
+		out[0] = '\0';
+}
+
+void dtmf_decoder_push(struct dtmf_decoder *dec, const char *col)
+{
+	if (dec->pending)
+		__dtmf_decoder(dec, dec->pend, col);
+
+	memcpy(dec->pend, col, dec->chan);
+	dec->pending = 1;
+}
+
+void dtmf_decoder_finish(struct dtmf_decoder *dec)
+{
+	if (dec->pending)
+		__dtmf_decoder(dec, dec->pend, NULL);
+	dec->pending = 0;
+
+	// all "?" case
+	if (!dec->comma)
+		for (int i = 0; i < dec->chan; i++)
+			dtmf_decoder_out(dec, unknown);
+}
+
+//=======================================
+//
+// dtmf_analyze_frames
+// dtmf_decode_result
+// dtmf_result_print
+//
+// analyze interleaved data on memory, and decode it
+//
+//	data   = [LRLRLRLR ...]
+//	result = [LLLL... RRRR...] (challenge x chan)
+//
+// dtmf_analyze_frames() returns challenge
+// kernel is from dtmf_kernel_select(), or NULL for generic
+//
+//=======================================
+int dtmf_analyze_frames(dtmf_kernel kernel, s16 *data, int length, int rate,
+			int chan, char *result)
+{
+	struct dtmf_level lv;
+	int width	= rate / 100 * DEGREE;
+	int challenge	= length / width;
+	int i, j;
+
+	for (i = 0; i < chan; i++)
+		for (j = 0; j < challenge; j++)
+			result[challenge * i + j] =
+				dtmf_analyze_kernel(kernel, data + (width * j * chan) + i,
+						    width, chan, rate, &lv);
+
+	return challenge;
+}
+
+void dtmf_decode_result(const char *result, int challenge, int chan, char *out, int size)
+{
+	struct dtmf_decoder dec;
+	int i, j;
+
+	dtmf_decoder_init(&dec, chan, out, size);
+	for (j = 0; j < challenge; j++) {
+		char col[MAX_CHAN];
+
+		for (i = 0; i < chan; i++)
+			col[i] = result[challenge * i + j];
+
+		dtmf_decoder_push(&dec, col);
+	}
+	dtmf_decoder_finish(&dec);
+}
+
+// -v print of each channels
+void dtmf_result_print(const char *result, int challenge, int chan)
+{
+	for (int i = 0; i < chan; i++) {
+		for (int j = 0; j < challenge; j++)
+			printf("%c", result[challenge * i + j]);
+		printf("\n");
+	}
+}
+
+//=======================================
+//
+// dtmf_onset
+//
+// Find tone "num" onset in [from, to) by its energy edge.
+//
+// It runs sliding DFT (window = win) on both tones.
+// The level rises linearly while the window is sliding into the tone,
+// and reaches 1/2 when window center meets the onset.
+//
+//	       onset
+//	         v
+//	buf = [__xxxxxxxxxx]
+//	     <-win->		level = 1/2
+//
+// Data is differentiated to remove DC (and its step on onset),
+// and the edge is fitted as a line to average out the ripple
+// which came from other frequency.
+//
+// return onset position as sub-sample, or -1
+//
+//=======================================
+#define ONSET_FIT	0.3	// fit range is +- 30% window around the edge
+double dtmf_onset(s16 *buf, int length, int rate, char num, int from, int to, int win)
+{
+	double re[2] = { 0, 0 };
+	double im[2] = { 0, 0 };
+	double omega[2];
+	double *level;
+	double *diff;
+	double max = 0;
+	double steady = 0;
+	double sx = 0, sy = 0, sxx = 0, sxy = 0;
+	double ret = -1;
+	int edge = -1;
+	int i, k, n, cnt;
+
+	if (from < 1)
+		from = 1;
+	if (to > length)
+		to = length;
+	if (to - from <= win * 2)
+		return -1;
+
+	for (i = 0; i < ARRAY_SIZE(tone_info); i++) {
+		if (tone_info[i].num == num) {
+			omega[0] = PI2 * tone_info[i].low / rate;
+			omega[1] = PI2 * tone_info[i].hi  / rate;
+			goto found;
+		}
+	}
+	return -1;
+
+found:
+	level = calloc(to - from, sizeof(double));
+	diff  = calloc(to - from, sizeof(double));
+	if (!level || !diff)
+		goto err;
+
+	for (n = from; n < to; n++)
+		diff[n - from] = buf[n] - buf[n - 1];
+
+	//==========================
+	// sliding DFT
+	//
+	// level[n - from] is the window which ends at n
+	//==========================
+	for (n = from; n < to; n++) {
+		level[n - from] = 0;
+		for (k = 0; k < 2; k++) {
+			re[k] += diff[n - from] * cos(omega[k] * n);
+			im[k] -= diff[n - from] * sin(omega[k] * n);
+			if (n - win >= from) {
+				re[k] -= diff[n - from - win] * cos(omega[k] * (n - win));
+				im[k] += diff[n - from - win] * sin(omega[k] * (n - win));
+			}
+			level[n - from] += sqrt(re[k] * re[k] + im[k] * im[k]);
+		}
+		if (n - from >= win - 1 && max < level[n - from])
+			max = level[n - from];
+	}
+
+	//==========================
+	// rough 1/2 level edge
+	//==========================
+	for (n = from; n < to; n++) {
+		if (level[n - from] >= max / 2) {
+			edge = n;
+			break;
+		}
+	}
+
+	//==========================
+	// steady level
+	//
+	// average of the windows which are fully in the tone
+	//==========================
+	cnt = 0;
+	for (n = edge + win * 5 / 8; n < to; n++, cnt++)
+		steady += level[n - from];
+	if (edge < 0 || !cnt)
+		goto err;
+	steady /= cnt;
+
+	//==========================
+	// fit the edge
+	//==========================
+	cnt = 0;
+	for (n = edge - win * ONSET_FIT; n < edge + win * ONSET_FIT; n++) {
+		if (n < from || n >= to)
+			continue;
+		sx  += n;
+		sy  += level[n - from];
+		sxx += (double)n * n;
+		sxy += n * level[n - from];
+		cnt++;
+	}
+	if (cnt < 2)
+		goto err;
+
+	// level = a + b * n
+	{
+		double b = (cnt * sxy - sx * sy) / (cnt * sxx - sx * sx);
+		double a = (sy - b * sx) / cnt;
+
+		if (b <= 0)
+			goto err;
+
+		ret = (steady / 2 - a) / b;
+		ret = ret + 1 - win / 2.0;
+	}
+err:
+	free(level);
+	free(diff);
+
+	return ret;
+}
+
+//=======================================
+//
+// dtmf_xrun
+//
+// Find discontinuity (= xrun) in tone "num" between [from, to).
+//
+// Steady 2 tones (+ DC) signal satisfies below linear recurrence.
+//
+//	(1 - z^-1)(1 - c1 z^-1 + z^-2)(1 - c2 z^-1 + z^-2) x = 0
+//	c = 2 cos(omega)
+//
+// Its residual (= e) is almost zero (= quantization noise) while tone
+// phase and amplitude are continuous, and has spike when it jumped.
+// Drop (= overrun) will be 1 spike, inserted gap (= underrun) will be
+// spike - low energy part - spike.
+//
+// Dropped samples (= d) are estimated from phase jump of each tone.
+// Tone after drop is d samples advanced.
+//
+//	phase(after) - phase(before) = omega * d	(mod 2pi)
+//
+// d is searched up to 1 challenge (100ms) which satisfies both tones.
+// Tone after gap is delayed (d = -gap). If not, it was other tone
+// (ex 2 same dtmf with short silence), not xrun.
+//
+// return number of detected xrun (up to "max")
+//
+//=======================================
+#define XRUN_ORDER	5	// recurrence order
+#define XRUN_SIGMA	6	// spike threshold (x noise)
+#define XRUN_GAP	16	// gap energy is lower than 1/16 of tone
+#define XRUN_PHASE(rate)	((rate) / 20)	// 50ms for phase
+#define XRUN_DROP(rate)		((rate) / 10)	// 100ms
+#define XRUN_TOL	0.2	// phase cost of delayed tone after gap
+
+// Hann windowed phase of fq on buf[from, to)
+static double xrun_phase(s16 *buf, int from, int to, int rate, int fq)
+{
+	double real = 0, imag = 0;
+	double w;
+
+	for (int n = from; n < to; n++) {
+		w = 0.5 - 0.5 * cos(PI2 * (n - from) / (to - from));
+		real += w * buf[n] * cos(PI2 * fq / rate * n);
+		imag -= w * buf[n] * sin(PI2 * fq / rate * n);
+	}
+
+	return atan2(imag, real);
+}
+
+// shift d in [dmin, dmax] of buf[end, to) from buf[from, pos).
+// best is its phase cost, or -1 if it doesn't have enough data
+static int xrun_shift(s16 *buf, int from, int to, int rate, const int *fq,
+		      int pos, int end, int dmin, int dmax, double *best)
+{
+	double diff[2];
+	double cost;
+	int len = XRUN_PHASE(rate);
+	int ret = 0;
+	int i, d;
+
+	*best = -1;
+	if (pos - from < len / 2 || to - end < len / 2)
 		return 0;
+	if (pos - from > len)
+		from = pos - len;
+	if (to - end > len)
+		to = end + len;
+
+	for (i = 0; i < 2; i++)
+		diff[i] = xrun_phase(buf, end,  to,  rate, fq[i]) -
+			  xrun_phase(buf, from, pos, rate, fq[i]);
+
+	for (d = dmin; d <= dmax; d++) {
+		cost = 0;
+		for (i = 0; i < 2; i++)
+			cost += 1 - cos(diff[i] - PI2 * fq[i] / rate * d);
+
+		if (*best < 0 || cost < *best) {
+			*best = cost;
+			ret   = d;
+		}
 	}
 
+	return ret;
+}
+
+int dtmf_xrun(s16 *buf, int length, int rate, char num, int from, int to,
+	      struct dtmf_xrun *xrun, int max)
+{
+	double a[XRUN_ORDER + 1];
+	double c1, c2, e, d;
+	double se = 0, sd = 0;
+	int fq[2];
+	double thr;
+	int cnt = 0;
+	int nr = 0;
+	int last = -1;
+	int i, n;
+
+	if (from < XRUN_ORDER)
+		from = XRUN_ORDER;
+	if (to > length)
+		to = length;
+	if (to - from <= XRUN_ORDER)
+		return 0;
 
 	for (i = 0; i < ARRAY_SIZE(tone_info); i++) {
 		if (tone_info[i].num == num) {
-			tone_hi  = tone_info[i].hi;
-			tone_low = tone_info[i].low;
+			fq[0] = tone_info[i].low;
+			fq[1] = tone_info[i].hi;
+			c1 = 2 * cos(PI2 * tone_info[i].low / rate);
+			c2 = 2 * cos(PI2 * tone_info[i].hi  / rate);
 			goto found;
 		}
 	}
-	return -EINVAL;
+	return 0;
 
 found:
+	a[0] = 1;
+	a[1] = -(c1 + c2) - 1;
+	a[2] =  (2 + c1 * c2) + (c1 + c2);
+	a[3] = -(c1 + c2) - (2 + c1 * c2);
+	a[4] =  (c1 + c2) + 1;
+	a[5] = -1;
+
+#define residual(n) (a[0] * buf[n]     + a[1] * buf[n - 1] + a[2] * buf[n - 2] +	\
+		     a[3] * buf[n - 3] + a[4] * buf[n - 4] + a[5] * buf[n - 5])
+
+	//==========================
+	// noise level
+	//
+	// 2nd loop ignores spike
+	//==========================
+	for (n = from; n < to; n++) {
+		e   = residual(n);
+		se += e * e;
+	}
+	thr = XRUN_SIGMA * sqrt(se / (to - from));
+
+	se = 0;
+	for (n = from; n < to; n++) {
+		e = residual(n);
+		d = buf[n] - buf[n - 1];
+		sd += d * d;
+		if (fabs(e) > thr)
+			continue;
+		se += e * e;
+		cnt++;
+	}
+	if (!cnt)
+		return 0;
+	thr = XRUN_SIGMA * sqrt(se / cnt) + 1;
+	sd  = sd / (to - from);
+
+	//==========================
+	// find spike
+	//==========================
+	for (n = from; n < to; n++) {
+		e = residual(n);
+		if (fabs(e) <= thr)
+			continue;
+
+		// continued spike
+		if (nr && n - last <= XRUN_ORDER + 1)
+			goto next;
+
+		// low energy gap from previous spike ?
+		if (nr) {
+			double gap = 0;
+
+			for (i = last + 1; i < n; i++) {
+				d = buf[i] - buf[i - 1];
+				gap += d * d;
+			}
+			if (gap / (n - last - 1) * XRUN_GAP < sd)
+				goto next;
+		}
+
+		if (nr == max)
+			break;
+
+		xrun[nr].pos = n;
+		nr++;
+next:
+		last = n;
+		xrun[nr - 1].len = last - xrun[nr - 1].pos;
+	}
+#undef residual
+
+	// spike continues XRUN_ORDER samples after discontinuity
+	// (= last spike is XRUN_ORDER - 1 samples after it)
+	for (i = 0; i < nr; i++) {
+		xrun[i].len -= XRUN_ORDER - 1;
+		if (xrun[i].len < 0)
+			xrun[i].len = 0;
+	}
+
+	// check phase between neighbor xrun.
+	// xrun[i - 1] is not yet overwritten, because n <= i
+	for (i = 0, n = 0; i < nr; i++) {
+		struct dtmf_xrun x = xrun[i];
+		int lo = i          ? xrun[i - 1].pos + xrun[i - 1].len + XRUN_ORDER : from;
+		int hi = i + 1 < nr ? xrun[i + 1].pos : to;
+		double cost;
+
+		x.drop = 0;
+		if (!x.len)
+			x.drop = xrun_shift(buf, lo, hi, rate, fq, x.pos, x.pos,
+					    1, XRUN_DROP(rate) - 1, &cost);
+		else
+			xrun_shift(buf, lo, hi, rate, fq, x.pos, x.pos + x.len,
+				   -x.len - 2, -x.len + 2, &cost);
+
+		// gap, but other tone (or can't confirm it)
+		if (x.len && (cost < 0 || cost > XRUN_TOL))
+			continue;
+
+		xrun[n++] = x;
+	}
+
+	return n;
+}
+
+//=======================================
+//
+// dtmf_drift_flush
+// dtmf_drift_update
+// dtmf_drift_ppm
+//
+// Estimate actual tone frequency from Goertzel phase slope.
+//
+// Each window (= length) phase advances omega * length if tone was
+// nominal frequency. The difference is frequency offset.
+//
+//	phase
+//	  ^      x  x
+//	  |   x  x		slope = (omega' - omega) * length
+//	  |x
+//	  +-----------> window
+//
+// Phase is unwrapped on continuous windows (= segment), and slope is
+// least squares fit which is pooled over segments.
+// It doesn't keep data, so it can handle long file in 1 pass.
+//
+//=======================================
+void dtmf_drift_flush(struct dtmf_drift *dr)
+{
+	if (dr->n > 1) {
+		dr->sxx += dr->stt - dr->st * dr->st / dr->n;
+		dr->sxy += dr->stp - dr->st * dr->sp / dr->n;
+	}
+
+	dr->n	= 0;
+	dr->st	= 0;
+	dr->sp	= 0;
+	dr->stt	= 0;
+	dr->stp	= 0;
+}
+
+void dtmf_drift_update(struct dtmf_drift *dr, s16 *buf, int length, int rate,
+		       int fq, int window)
+{
+	dtmf_data_init(data, buf, length);
+	double real, imag;
+	double phase, diff;
+	double t;
+
+	__goertzel(&data, rate, fq, &real, &imag);
+	phase = atan2(imag, real);
+
+	// new segment
+	if (!dr->n || window != dr->last + 1) {
+		dtmf_drift_flush(dr);
+		dr->unwrap = phase;
+		dr->t0     = window;
+	} else {
+		diff = phase - dr->phase - fmod(PI2 * fq / rate * length, PI2);
+		diff = diff - PI2 * floor((diff + M_PI) / PI2);
+		dr->unwrap += diff;
+	}
+
+	t = window - dr->t0;
+	dr->n++;
+	dr->st	+= t;
+	dr->sp	+= dr->unwrap;
+	dr->stt	+= t * t;
+	dr->stp	+= t * dr->unwrap;
+
+	dr->phase = phase;
+	dr->last  = window;
+}
+
+// return 0 if it can't estimate
+double dtmf_drift_ppm(struct dtmf_drift *dr, int length, int rate, int fq)
+{
+	double slope;
+
+	dtmf_drift_flush(dr);
+
+	if (dr->sxx <= 0)
+		return 0;
+
+	// rad/window -> Hz
+	slope = dr->sxy / dr->sxx;
+	slope = slope * rate / (PI2 * length);
+
+	return slope / fq * 1000000;
+}
+
+//=======================================
+//
+// dtmf_fill_tone
+// dtmf_fill
+//
+// dtmf_fill_tone() fills any low/hi tone pair
+//
+//=======================================
+int dtmf_fill_tone(s16 *buf, int length, int rate, int sample, int tone_low, int tone_hi)
+{
+	long volume		= 40000000 / rate;
+	double phase_low	= 0;
+	double phase_hi		= 0;
+	double add_low;
+	double add_hi;
+	int i, v = 0;
+
 	add_low		= PI2 * tone_low / rate;
 	add_hi		= PI2 * tone_hi  / rate;
 	for (i = 0; i < length; i++) {
@@ -188,3 +990,23 @@ found:
 
 	return 0;
 }
+
+int dtmf_fill(s16 *buf, int length, int rate, int sample, char num)
+{
+	int i;
+
+	if (num == '_') {
+		/* do nothing */
+		memset(buf, 0, length * sample);
+		return 0;
+	}
+
+
+	for (i = 0; i < ARRAY_SIZE(tone_info); i++)
+		if (tone_info[i].num == num)
+			return dtmf_fill_tone(buf, length, rate, sample,
+					      tone_info[i].low,
+					      tone_info[i].hi);
+
+	return -EINVAL;
+}
@@ -0,0 +1,785 @@
+// SPDX-License-Identifier: GPLv2
+//
+// flac.c
+//
+// Copyright (c) 2026 agent <agent@local>
+//
+#include "param.h"
+
+//=================================================
+//
+//
+//		defines
+//
+//
+//=================================================
+//
+// streaming FLAC decoder for -i
+//
+// It decodes each frame, and puts it to planar buffer of each channel.
+// Each challenge is analyzed as soon as it became available.
+// Whole file is never kept.
+//
+//	      frame    frame    frame
+//	file = [hhhhhh][hhhhhh][hhhhhh]...
+//	            |
+//	            v  decode, decorrelate
+//	buf  = [ch0 ..........<- fill ->     ]
+//	       [ch1 ..........               ]
+//	        <- width -> analyze, and shift
+//
+// frame is int, not s16. side channel has 17bit, and residual is
+// decoded in place before prediction which might be over 16bit.
+// It is converted to s16 when it was copied to buf.
+//
+// -v needs all results before decoded string (same as wav), thus
+// it keeps each challenge result.
+//
+// 16bit only, same as wav.c
+// CRC-8 (header) / CRC-16 (frame) are checked.
+//
+#define FLAC_MAGIC		"fLaC"
+#define FLAC_BUF		(64 * 1024)
+#define FLAC_STREAMINFO		0
+#define FLAC_MAX_ORDER		32
+#define FLAC_SYNC		0x3FFE
+
+struct flac {
+	FILE *fp;
+
+	// byte buffer
+	unsigned char buf[FLAC_BUF];
+	int len;
+	int pos;
+	int eof;
+
+	// bit cache (MSB aligned)
+	u64 bits;
+	int nbits;
+
+	unsigned char crc8;
+	unsigned short crc16;
+
+	// STREAMINFO
+	int min_block;
+	int max_block;
+	int rate;
+	int chan;
+	int bps;
+	u64 total;
+
+	// 1 frame of each channels
+	int *frame[MAX_CHAN];
+};
+
+static unsigned char  flac_crc8_table[256];
+static unsigned short flac_crc16_table[256];
+
+//=======================================
+//
+// flac_crc_init
+//
+//=======================================
+static void flac_crc_init(void)
+{
+	for (int i = 0; i < 256; i++) {
+		unsigned char  c8  = i;
+		unsigned short c16 = i << 8;
+
+		for (int j = 0; j < 8; j++) {
+			c8  = (c8  & 0x80)   ? (c8  << 1) ^ 0x07   : (c8  << 1);
+			c16 = (c16 & 0x8000) ? (c16 << 1) ^ 0x8005 : (c16 << 1);
+		}
+
+		flac_crc8_table[i]  = c8;
+		flac_crc16_table[i] = c16;
+	}
+}
+
+//=======================================
+//
+// flac_byte
+// flac_bits
+// flac_sbits
+// flac_unary
+// flac_align
+//
+// bit reader. CRC is updated on each byte
+//
+//=======================================
+static int flac_byte(struct flac *flac)
+{
+	unsigned char c;
+
+	if (flac->pos == flac->len) {
+		prof_start(PROF_READ);
+		flac->len = fread(flac->buf, 1, FLAC_BUF, flac->fp);
+		prof_stop(PROF_READ);
+		prof_add(PROF_CALLS, 1);
+		prof_add(PROF_BYTES, flac->len);
+		flac->pos = 0;
+		if (!flac->len) {
+			flac->eof = 1;
+			return 0;
+		}
+	}
+
+	c = flac->buf[flac->pos++];
+
+	flac->crc8  = flac_crc8_table[flac->crc8 ^ c];
+	flac->crc16 = (flac->crc16 << 8) ^ flac_crc16_table[(flac->crc16 >> 8) ^ c];
+
+	return c;
+}
+
+static u32 flac_bits(struct flac *flac, int n)
+{
+	u32 v;
+
+	if (!n)
+		return 0;
+
+	while (flac->nbits < n) {
+		flac->bits  |= (u64)flac_byte(flac) << (56 - flac->nbits);
+		flac->nbits += 8;
+	}
+
+	v = flac->bits >> (64 - n);
+	flac->bits  <<= n;
+	flac->nbits  -= n;
+
+	return v;
+}
+
+static int flac_sbits(struct flac *flac, int n)
+{
+	u32 v = flac_bits(flac, n);
+
+	if (!n)
+		return 0;
+
+	// sign extend
+	return (int)(v << (32 - n)) >> (32 - n);
+}
+
+static u32 flac_unary(struct flac *flac)
+{
+	u32 count = 0;
+	int lz;
+
+	// count 0 until 1
+	while (!flac->bits) {
+		count += flac->nbits;
+		flac->nbits = 8;
+		flac->bits  = (u64)flac_byte(flac) << 56;
+		if (flac->eof)
+			return count;
+	}
+
+	// invalid bits are always 0, thus clz < nbits
+	lz = __builtin_clzll(flac->bits);
+
+	count	    += lz;
+	flac->bits <<= lz + 1;
+	flac->nbits -= lz + 1;
+
+	return count;
+}
+
+static void flac_align(struct flac *flac)
+{
+	flac_bits(flac, flac->nbits % 8);
+}
+
+//=======================================
+//
+// flac_header
+//
+// "fLaC" + metadata blocks
+//
+//=======================================
+static int flac_header(struct flac *flac)
+{
+	int last, type, len;
+
+	if (flac_bits(flac, 8) != 'f' ||
+	    flac_bits(flac, 8) != 'L' ||
+	    flac_bits(flac, 8) != 'a' ||
+	    flac_bits(flac, 8) != 'C')
+		return -EINVAL;
+
+	do {
+		last = flac_bits(flac, 1);
+		type = flac_bits(flac, 7);
+		len  = flac_bits(flac, 24);
+
+		if (type != FLAC_STREAMINFO) {
+			while (len--)
+				flac_bits(flac, 8);
+			continue;
+		}
+
+		if (len != 34)
+			return -EINVAL;
+
+		flac->min_block	= flac_bits(flac, 16);
+		flac->max_block	= flac_bits(flac, 16);
+		flac_bits(flac, 24);	// min frame size
+		flac_bits(flac, 24);	// max frame size
+		flac->rate	= flac_bits(flac, 20);
+		flac->chan	= flac_bits(flac, 3) + 1;
+		flac->bps	= flac_bits(flac, 5) + 1;
+		flac->total	= (u64)flac_bits(flac, 4) << 32;
+		flac->total    |= flac_bits(flac, 32);
+		for (int i = 0; i < 16; i++)
+			flac_bits(flac, 8);	// MD5
+	} while (!last && !flac->eof);
+
+	if (flac->eof			||
+	    flac->bps != 16		||	// 16bit only for now
+	    flac->chan > MAX_CHAN	||
+	    flac->rate == 0		||
+	    flac->max_block < 16)
+		return -EINVAL;
+
+	return 0;
+}
+
+//=======================================
+//
+// flac_residual
+//
+// partitioned Rice coding
+//
+//=======================================
+static int flac_residual(struct flac *flac, int *res, int block, int order)
+{
+	int method	= flac_bits(flac, 2);
+	int part_order	= flac_bits(flac, 4);
+	int param_bits	= method ? 5 : 4;
+	int escape	= method ? 31 : 15;
+	int part	= block >> part_order;
+	int i, n;
+
+	if (method > 1 || (block & ((1 << part_order) - 1)) || part < order)
+		return -EINVAL;
+
+	for (int p = 0; p < (1 << part_order); p++) {
+		int k = flac_bits(flac, param_bits);
+
+		// 1st partition doesn't have warm-up part
+		n = p ? part : part - order;
+
+		if (k == escape) {
+			k = flac_bits(flac, 5);
+			for (i = 0; i < n; i++)
+				*res++ = flac_sbits(flac, k);
+			continue;
+		}
+
+		for (i = 0; i < n; i++) {
+			u32 v = (flac_unary(flac) << k) | flac_bits(flac, k);
+
+			*res++ = (v >> 1) ^ -(int)(v & 1);
+		}
+	}
+
+	return flac->eof ? -EIO : 0;
+}
+
+//=======================================
+//
+// flac_subframe
+//
+//=======================================
+static int flac_subframe(struct flac *flac, int *out, int block, int bps)
+{
+	int coef[FLAC_MAX_ORDER];
+	int type, wasted = 0;
+	int order, precision, shift;
+	int i, j, ret;
+
+	if (flac_bits(flac, 1))
+		return -EINVAL;
+
+	type = flac_bits(flac, 6);
+
+	if (flac_bits(flac, 1))
+		wasted = flac_unary(flac) + 1;
+	bps -= wasted;
+	if (bps <= 0)
+		return -EINVAL;
+
+	//==========================
+	// CONSTANT
+	//==========================
+	if (type == 0) {
+		int v = flac_sbits(flac, bps);
+
+		for (i = 0; i < block; i++)
+			out[i] = v;
+		goto wasted;
+	}
+
+	//==========================
+	// VERBATIM
+	//==========================
+	if (type == 1) {
+		for (i = 0; i < block; i++)
+			out[i] = flac_sbits(flac, bps);
+		goto wasted;
+	}
+
+	//==========================
+	// FIXED
+	//==========================
+	if (type >= 8 && type <= 12) {
+		order = type - 8;
+		if (order > block)
+			return -EINVAL;
+
+		for (i = 0; i < order; i++)
+			out[i] = flac_sbits(flac, bps);
+
+		ret = flac_residual(flac, out + order, block, order);
+		if (ret < 0)
+			return ret;
+
+		switch (order) {
+		case 1:
+			for (i = 1; i < block; i++)
+				out[i] += out[i - 1];
+			break;
+		case 2:
+			for (i = 2; i < block; i++)
+				out[i] += 2 * out[i - 1] - out[i - 2];
+			break;
+		case 3:
+			for (i = 3; i < block; i++)
+				out[i] += 3 * out[i - 1] - 3 * out[i - 2] + out[i - 3];
+			break;
+		case 4:
+			for (i = 4; i < block; i++)
+				out[i] += 4 * out[i - 1] - 6 * out[i - 2] + 4 * out[i - 3] - out[i - 4];
+			break;
+		}
+		goto wasted;
+	}
+
+	//==========================
+	// LPC
+	//==========================
+	if (type >= 32) {
+		order = (type & 31) + 1;
+		if (order > block)
+			return -EINVAL;
+
+		for (i = 0; i < order; i++)
+			out[i] = flac_sbits(flac, bps);
+
+		precision = flac_bits(flac, 4) + 1;
+		if (precision == 16)
+			return -EINVAL;
+
+		shift = flac_sbits(flac, 5);
+		if (shift < 0)
+			return -EINVAL;
+
+		for (i = 0; i < order; i++)
+			coef[i] = flac_sbits(flac, precision);
+
+		ret = flac_residual(flac, out + order, block, order);
+		if (ret < 0)
+			return ret;
+
+		for (i = order; i < block; i++) {
+			long long sum = 0;
+
+			for (j = 0; j < order; j++)
+				sum += (long long)coef[j] * out[i - 1 - j];
+
+			out[i] += sum >> shift;
+		}
+		goto wasted;
+	}
+
+	return -EINVAL;
+wasted:
+	if (wasted)
+		for (i = 0; i < block; i++)
+			out[i] <<= wasted;
+
+	return flac->eof ? -EIO : 0;
+}
+
+//=======================================
+//
+// flac_frame
+//
+// return block size, 0 if end of stream
+//
+//=======================================
+static const int flac_rate_table[] = {
+	0, 88200, 176400, 192000, 8000, 16000, 22050, 24000,
+	32000, 44100, 48000, 96000,
+};
+
+static const int flac_bps_table[] = {
+	0, 8, 12, 0, 16, 20, 24, 32,
+};
+
+static int flac_frame(struct flac *flac)
+{
+	int block, rate, assign, bps, chan;
+	int code, c, i;
+	unsigned char crc8;
+	int ret;
+
+	//==========================
+	// frame header
+	//==========================
+	flac->crc8  = 0;
+	flac->crc16 = 0;
+
+	code = flac_bits(flac, 14);
+	if (flac->eof)
+		return 0;
+	if (code != FLAC_SYNC)
+		return -EINVAL;
+
+	flac_bits(flac, 1);	// reserved
+	flac_bits(flac, 1);	// blocking strategy
+
+	block	= flac_bits(flac, 4);
+	rate	= flac_bits(flac, 4);
+	assign	= flac_bits(flac, 4);
+	bps	= flac_bits(flac, 3);
+	flac_bits(flac, 1);	// reserved
+
+	// frame/sample number (UTF-8 like)
+	c = flac_bits(flac, 8);
+	for (i = 0x80; c & i; i >>= 1)
+		if (i != 0x80)
+			flac_bits(flac, 8);
+
+	switch (block) {
+	case 0:			return -EINVAL;
+	case 1:			block = 192;				break;
+	case 2 ... 5:		block = 576 << (block - 2);		break;
+	case 6:			block = flac_bits(flac, 8)  + 1;	break;
+	case 7:			block = flac_bits(flac, 16) + 1;	break;
+	default:		block = 256 << (block - 8);		break;
+	}
+
+	switch (rate) {
+	case 0:			rate = flac->rate;			break;
+	case 12:		rate = flac_bits(flac, 8) * 1000;	break;
+	case 13:		rate = flac_bits(flac, 16);		break;
+	case 14:		rate = flac_bits(flac, 16) * 10;	break;
+	case 15:		return -EINVAL;
+	default:		rate = flac_rate_table[rate];		break;
+	}
+
+	bps = bps ? flac_bps_table[bps] : flac->bps;
+
+	chan = (assign < 8) ? assign + 1 : 2;
+
+	// CRC-8 is for header, it is byte aligned here
+	crc8 = flac->crc8;
+	if (flac_bits(flac, 8) != crc8)
+		return -EIO;
+
+	if (block > flac->max_block	||
+	    rate  != flac->rate		||
+	    bps   != flac->bps		||
+	    chan  != flac->chan		||
+	    assign > 10)
+		return -EINVAL;
+
+	//==========================
+	// subframes
+	//
+	// side channel has 1 more bit
+	//==========================
+	for (c = 0; c < chan; c++) {
+		int side = ((assign == 8 || assign == 10) && c == 1) ||
+			    (assign == 9 && c == 0);
+
+		ret = flac_subframe(flac, flac->frame[c], block, bps + side);
+		if (ret < 0)
+			return ret;
+	}
+
+	//==========================
+	// CRC-16 for whole frame
+	//==========================
+	flac_align(flac);
+	{
+		unsigned short crc16 = flac->crc16;
+
+		if (flac_bits(flac, 16) != crc16)
+			return -EIO;
+	}
+
+	//==========================
+	// decorrelate
+	//==========================
+	{
+		int *ch0 = flac->frame[0];
+		int *ch1 = flac->frame[1];
+
+		switch (assign) {
+		case 8:		// left/side
+			for (i = 0; i < block; i++)
+				ch1[i] = ch0[i] - ch1[i];
+			break;
+		case 9:		// side/right
+			for (i = 0; i < block; i++)
+				ch0[i] += ch1[i];
+			break;
+		case 10:	// mid/side
+			for (i = 0; i < block; i++) {
+				int mid  = ((unsigned)ch0[i] << 1) | (ch1[i] & 1);
+				int side = ch1[i];
+
+				ch0[i] = (mid + side) >> 1;
+				ch1[i] = (mid - side) >> 1;
+			}
+			break;
+		}
+	}
+
+	return block;
+}
+
+//=======================================
+//
+// dtmf_flac_check
+//
+// return 1 if it was FLAC file
+//
+//=======================================
+int dtmf_flac_check(struct dev_param *param)
+{
+	char magic[4];
+	FILE *fp;
+	int ret = 0;
+
+	fp = fopen(param->filename, "r");
+	if (!fp)
+		return 0;
+
+	if (fread(magic, sizeof(magic), 1, fp) &&
+	    !memcmp(magic, FLAC_MAGIC, sizeof(magic)))
+		ret = 1;
+
+	fclose(fp);
+
+	return ret;
+}
+
+//=======================================
+//
+// flac_verbose
+//
+// -v prints same as wav
+//
+//	cols   = [LR LR LR ...]
+//	result = [LLL... RRR...]
+//
+//=======================================
+static int flac_verbose(const char *cols, int challenge, int chan)
+{
+	int size = (challenge + 1) * (chan + 1);
+	char *result = calloc(challenge + 1, chan);
+	char *out = calloc(1, size);
+	int ret = -ENOMEM;
+
+	if (!result || !out)
+		goto err;
+
+	for (int c = 0; c < chan; c++)
+		for (int j = 0; j < challenge; j++)
+			result[challenge * c + j] = cols[chan * j + c];
+
+	dtmf_result_print(result, challenge, chan);
+
+	prof_start(PROF_DECIDE);
+	dtmf_decode_result(result, challenge, chan, out, size);
+	prof_stop(PROF_DECIDE);
+
+	printf("%s", out);
+
+	ret = 0;
+err:
+	free(result);
+	free(out);
+
+	return ret;
+}
+
+//=======================================
+//
+// dtmf_flac_analyze
+//
+//=======================================
+int dtmf_flac_analyze(struct dev_param *param)
+{
+	struct dtmf_decoder dec;
+	struct dtmf_level lv;
+	struct flac *flac;
+	s16 *buf[MAX_CHAN];
+	char *cols = NULL;	// -v : [LR LR LR ...]
+	int challenge = 0;
+	int nr = 0;
+	int width, size;
+	int fill, pos;
+	int block;
+	int ret = -ENOMEM;
+	int i, c;
+
+	flac = calloc(1, sizeof(*flac));
+	if (!flac)
+		goto err;
+
+	flac_crc_init();
+
+	ret = -ENOENT;
+	flac->fp = fopen(param->filename, "r");
+	if (!flac->fp)
+		goto free;
+	prof_add(PROF_CALLS, 1);
+
+	//==========================
+	// read header, and fill params
+	//==========================
+	prof_start(PROF_HEADER);
+	ret = flac_header(flac);
+	prof_stop(PROF_HEADER);
+	if (ret < 0)
+		goto close;
+
+	param->chan	= flac->chan;
+	param->rate	= flac->rate;
+	param->sample	= flac->bps / 8;
+	param->length	= flac->total;
+
+	if (param->flag & FLAG_VERBOSE) {
+		printf("chan    : %d\n", param->chan);
+		printf("rate    : %d\n", param->rate);
+		printf("bit     : %d\n", param->sample * 8);
+		printf("length  : %d\n", param->length);
+	}
+
+	ret   = -EINVAL;
+	width = param->rate / 100 * DEGREE;
+	if (width <= 0)
+		goto close;
+	param->kernel = dtmf_kernel_select(param->rate, width);
+
+	//==========================
+	// alloc buffers
+	//
+	// frame : 1 frame for each channels (decoded)
+	// buf   : planar buffer for each channels, it keeps
+	//	   less than 1 challenge + 1 frame
+	//==========================
+	ret  = -ENOMEM;
+	size = width + flac->max_block;
+	param->buf = calloc((size_t)size * flac->chan, sizeof(s16));
+	if (!param->buf)
+		goto close;
+
+	for (c = 0; c < flac->chan; c++) {
+		buf[c] = param->buf + size * c;
+		flac->frame[c] = calloc(flac->max_block, sizeof(int));
+		if (!flac->frame[c])
+			goto close;
+	}
+
+	// -v keeps each challenge result (total is 0 if unknown)
+	if (param->flag & FLAG_VERBOSE) {
+		nr   = param->length / width + 1;
+		cols = calloc(nr, param->chan);
+		if (!cols)
+			goto close;
+	}
+
+	// print result directly
+	dtmf_decoder_init(&dec, param->chan, NULL, 0);
+
+	fill = 0;
+	while (1) {
+		prof_start(PROF_COMPUTE);
+		block = flac_frame(flac);
+		prof_stop(PROF_COMPUTE);
+
+		ret = block;
+		if (block <= 0)
+			break;
+
+		for (c = 0; c < flac->chan; c++)
+			for (i = 0; i < block; i++)
+				buf[c][fill + i] = flac->frame[c][i];
+		fill += block;
+
+		//==========================
+		// analyze each challenge
+		//==========================
+		for (pos = 0; fill - pos >= width; pos += width, challenge++) {
+			char col[MAX_CHAN];
+
+			prof_start(PROF_COMPUTE);
+			for (c = 0; c < flac->chan; c++)
+				col[c] = dtmf_analyze_kernel(param->kernel, buf[c] + pos, width, 1,
+							     param->rate, &lv);
+			prof_stop(PROF_COMPUTE);
+			prof_add(PROF_ANALYZED, param->chan);
+			prof_add(PROF_SAMPLES,  param->chan * width);
+
+			if (cols) {
+				if (challenge == nr) {
+					char *p = realloc(cols, nr * 2 * param->chan);
+
+					ret = -ENOMEM;
+					if (!p)
+						goto close;
+					cols = p;
+					nr  *= 2;
+				}
+				memcpy(cols + challenge * param->chan, col, param->chan);
+				continue;
+			}
+
+			prof_start(PROF_DECIDE);
+			dtmf_decoder_push(&dec, col);
+			prof_stop(PROF_DECIDE);
+		}
+
+		// shift rest (less than width) once for each frame
+		fill -= pos;
+		for (c = 0; pos && c < flac->chan; c++)
+			memmove(buf[c], buf[c] + pos, fill * sizeof(s16));
+	}
+
+	if (cols) {
+		i = flac_verbose(cols, challenge, param->chan);
+		if (i < 0)
+			ret = i;
+	} else {
+		dtmf_decoder_finish(&dec);
+	}
+	printf("\n");
+close:
+	free(cols);
+	for (c = 0; c < MAX_CHAN; c++)
+		free(flac->frame[c]);
+	free(param->buf);
+	param->buf = NULL;
+	if (flac->fp)
+		fclose(flac->fp);
+free:
+	free(flac);
+err:
+	return ret;
+}
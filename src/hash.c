@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: GPLv2
+//
+// hash.c
+//
+// Copyright (c) 2026 agent <agent@local>
+//
+#include "common.h"
+
+//=================================================
+//
+//
+//		defines
+//
+//
+//=================================================
+//
+// XXH64 compatible streaming hash
+//
+#define PRIME1	0x9E3779B185EBCA87ULL
+#define PRIME2	0xC2B2AE3D27D4EB4FULL
+#define PRIME3	0x165667B19E3779F9ULL
+#define PRIME4	0x85EBCA77C2B2AE63ULL
+#define PRIME5	0x27D4EB2F165667C5ULL
+
+#define rotl(x, r)	(((x) << (r)) | ((x) >> (64 - (r))))
+
+static u64 read64(const unsigned char *p)
+{
+	u64 v;
+
+	memcpy(&v, p, sizeof(v));	// little endian only for now
+
+	return v;
+}
+
+static u32 read32(const unsigned char *p)
+{
+	u32 v;
+
+	memcpy(&v, p, sizeof(v));
+
+	return v;
+}
+
+static u64 round64(u64 acc, u64 input)
+{
+	acc += input * PRIME2;
+	acc  = rotl(acc, 31);
+	acc *= PRIME1;
+
+	return acc;
+}
+
+static u64 merge64(u64 acc, u64 val)
+{
+	acc ^= round64(0, val);
+	acc  = acc * PRIME1 + PRIME4;
+
+	return acc;
+}
+
+//=======================================
+//
+// hash_init
+// hash_update
+// hash_final
+//
+//=======================================
+void hash_init(struct hash *h, u64 seed)
+{
+	memset(h, 0, sizeof(*h));
+
+	h->v[0] = seed + PRIME1 + PRIME2;
+	h->v[1] = seed + PRIME2;
+	h->v[2] = seed;
+	h->v[3] = seed - PRIME1;
+	h->seed = seed;
+}
+
+void hash_update(struct hash *h, const void *data, size_t len)
+{
+	const unsigned char *p = data;
+	const unsigned char *end = p + len;
+
+	h->total += len;
+
+	// fill previous remaining
+	if (h->size) {
+		size_t fill = HASH_STRIPE - h->size;
+
+		if (fill > len)
+			fill = len;
+
+		memcpy(h->mem + h->size, p, fill);
+		h->size += fill;
+		p	+= fill;
+
+		if (h->size < HASH_STRIPE)
+			return;
+
+		for (int i = 0; i < 4; i++)
+			h->v[i] = round64(h->v[i], read64(h->mem + i * 8));
+		h->size = 0;
+	}
+
+	while (end - p >= HASH_STRIPE) {
+		for (int i = 0; i < 4; i++)
+			h->v[i] = round64(h->v[i], read64(p + i * 8));
+		p += HASH_STRIPE;
+	}
+
+	if (p < end) {
+		memcpy(h->mem, p, end - p);
+		h->size = end - p;
+	}
+}
+
+u64 hash_final(struct hash *h)
+{
+	const unsigned char *p = h->mem;
+	const unsigned char *end = p + h->size;
+	u64 acc;
+
+	if (h->total >= HASH_STRIPE) {
+		acc = rotl(h->v[0], 1) + rotl(h->v[1], 7) +
+		      rotl(h->v[2], 12) + rotl(h->v[3], 18);
+		for (int i = 0; i < 4; i++)
+			acc = merge64(acc, h->v[i]);
+	} else {
+		acc = h->seed + PRIME5;
+	}
+
+	acc += h->total;
+
+	while (end - p >= 8) {
+		acc ^= round64(0, read64(p));
+		acc  = rotl(acc, 27) * PRIME1 + PRIME4;
+		p += 8;
+	}
+
+	if (end - p >= 4) {
+		acc ^= (u64)read32(p) * PRIME1;
+		acc  = rotl(acc, 23) * PRIME2 + PRIME3;
+		p += 4;
+	}
+
+	while (p < end) {
+		acc ^= (*p) * PRIME5;
+		acc  = rotl(acc, 11) * PRIME1;
+		p++;
+	}
+
+	acc ^= acc >> 33;
+	acc *= PRIME2;
+	acc ^= acc >> 29;
+	acc *= PRIME3;
+	acc ^= acc >> 32;
+
+	return acc;
+}
+
+u64 hash64(const void *data, size_t len, u64 seed)
+{
+	struct hash h;
+
+	hash_init(&h, seed);
+	hash_update(&h, data, len);
+
+	return hash_final(&h);
+}
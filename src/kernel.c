@@ -0,0 +1,1183 @@
+// SPDX-License-Identifier: GPLv2
+//
+// kernel.c
+//
+// created by script/kernel.awk. Don't edit
+//
+#include "param.h"
+
+//=======================================
+//
+// 8000 Hz : width 800
+//
+//=======================================
+static void kernel_8000(const s16 *buf, int stride, double *level)
+{
+	double q1_0 = 0, q2_0 = 0;
+	double q1_1 = 0, q2_1 = 0;
+	double q1_2 = 0, q2_2 = 0;
+	double q1_3 = 0, q2_3 = 0;
+	double q1_4 = 0, q2_4 = 0;
+	double q1_5 = 0, q2_5 = 0;
+	double q1_6 = 0, q2_6 = 0;
+	double q1_7 = 0, q2_7 = 0;
+	double q0, real, imag;
+	int i;
+
+	for (i = 0; i < 800; i += 2, buf += stride * 2) {
+		q0 = 1.7077378093489017 * q1_0 - q2_0 + buf[0];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.6452810360417196 * q1_1 - q2_1 + buf[0];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.56868698386682 * q1_2 - q2_2 + buf[0];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.4782045682401759 * q1_3 - q2_3 + buf[0];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.1641040230273316 * q1_4 - q2_4 + buf[0];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 0.99637021067898168 * q1_5 - q2_5 + buf[0];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 0.79861838922663619 * q1_6 - q2_6 + buf[0];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 0.56853270677520196 * q1_7 - q2_7 + buf[0];
+		q2_7 = q1_7;
+		q1_7 = q0;
+		q0 = 1.7077378093489017 * q1_0 - q2_0 + buf[stride];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.6452810360417196 * q1_1 - q2_1 + buf[stride];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.56868698386682 * q1_2 - q2_2 + buf[stride];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.4782045682401759 * q1_3 - q2_3 + buf[stride];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.1641040230273316 * q1_4 - q2_4 + buf[stride];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 0.99637021067898168 * q1_5 - q2_5 + buf[stride];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 0.79861838922663619 * q1_6 - q2_6 + buf[stride];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 0.56853270677520196 * q1_7 - q2_7 + buf[stride];
+		q2_7 = q1_7;
+		q1_7 = q0;
+	}
+
+	real = (q1_0 - q2_0 * 0.85386890467445087) / 400.0;
+	imag = (q2_0 * 0.52048813015289175) / 400.0;
+	level[0] = sqrt(real * real + imag * imag);
+	real = (q1_1 - q2_1 * 0.8226405180208598) / 400.0;
+	imag = (q2_1 * 0.56856185073426391) / 400.0;
+	level[1] = sqrt(real * real + imag * imag);
+	real = (q1_2 - q2_2 * 0.78434349193341002) / 400.0;
+	imag = (q2_2 * 0.62032675797655601) / 400.0;
+	level[2] = sqrt(real * real + imag * imag);
+	real = (q1_3 - q2_3 * 0.73910228412008794) / 400.0;
+	imag = (q2_3 * 0.67359321077967294) / 400.0;
+	level[3] = sqrt(real * real + imag * imag);
+	real = (q1_4 - q2_4 * 0.58205201151366581) / 400.0;
+	imag = (q2_4 * 0.81315155776330861) / 400.0;
+	level[4] = sqrt(real * real + imag * imag);
+	real = (q1_5 - q2_5 * 0.49818510533949084) / 400.0;
+	imag = (q2_5 * 0.86707070116449003) / 400.0;
+	level[5] = sqrt(real * real + imag * imag);
+	real = (q1_6 - q2_6 * 0.3993091946133181) / 400.0;
+	imag = (q2_6 * 0.91681632135191793) / 400.0;
+	level[6] = sqrt(real * real + imag * imag);
+	real = (q1_7 - q2_7 * 0.28426635338760098) / 400.0;
+	imag = (q2_7 * 0.95874534696743929) / 400.0;
+	level[7] = sqrt(real * real + imag * imag);
+}
+
+//=======================================
+//
+// 11025 Hz : width 1100
+//
+//=======================================
+static void kernel_11025(const s16 *buf, int stride, double *level)
+{
+	double q1_0 = 0, q2_0 = 0;
+	double q1_1 = 0, q2_1 = 0;
+	double q1_2 = 0, q2_2 = 0;
+	double q1_3 = 0, q2_3 = 0;
+	double q1_4 = 0, q2_4 = 0;
+	double q1_5 = 0, q2_5 = 0;
+	double q1_6 = 0, q2_6 = 0;
+	double q1_7 = 0, q2_7 = 0;
+	double q0, real, imag;
+	int i;
+
+	for (i = 0; i < 1100; i += 2, buf += stride * 2) {
+		q0 = 1.844277951453285 * q1_0 - q2_0 + buf[0];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.8105024905620295 * q1_1 - q2_1 + buf[0];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.7688295940273751 * q1_2 - q2_2 + buf[0];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.7192315485884344 * q1_3 - q2_3 + buf[0];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.5437474901511352 * q1_4 - q2_4 + buf[0];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.4477540657765442 * q1_5 - q2_5 + buf[0];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.3323212884598155 * q1_6 - q2_6 + buf[0];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.1946219170257584 * q1_7 - q2_7 + buf[0];
+		q2_7 = q1_7;
+		q1_7 = q0;
+		q0 = 1.844277951453285 * q1_0 - q2_0 + buf[stride];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.8105024905620295 * q1_1 - q2_1 + buf[stride];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.7688295940273751 * q1_2 - q2_2 + buf[stride];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.7192315485884344 * q1_3 - q2_3 + buf[stride];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.5437474901511352 * q1_4 - q2_4 + buf[stride];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.4477540657765442 * q1_5 - q2_5 + buf[stride];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.3323212884598155 * q1_6 - q2_6 + buf[stride];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.1946219170257584 * q1_7 - q2_7 + buf[stride];
+		q2_7 = q1_7;
+		q1_7 = q0;
+	}
+
+	real = (q1_0 - q2_0 * 0.9221389757266425) / 550.0;
+	imag = (q2_0 * 0.38685877196441937) / 550.0;
+	level[0] = sqrt(real * real + imag * imag);
+	real = (q1_1 - q2_1 * 0.90525124528101475) / 550.0;
+	imag = (q2_1 * 0.42487666788983847) / 550.0;
+	level[1] = sqrt(real * real + imag * imag);
+	real = (q1_2 - q2_2 * 0.88441479701368753) / 550.0;
+	imag = (q2_2 * 0.46670168932974504) / 550.0;
+	level[2] = sqrt(real * real + imag * imag);
+	real = (q1_3 - q2_3 * 0.85961577429421721) / 550.0;
+	imag = (q2_3 * 0.51094101478013432) / 550.0;
+	level[3] = sqrt(real * real + imag * imag);
+	real = (q1_4 - q2_4 * 0.77187374507556761) / 550.0;
+	imag = (q2_4 * 0.63577584230844897) / 550.0;
+	level[4] = sqrt(real * real + imag * imag);
+	real = (q1_5 - q2_5 * 0.7238770328882721) / 550.0;
+	imag = (q2_5 * 0.68992901175184063) / 550.0;
+	level[5] = sqrt(real * real + imag * imag);
+	real = (q1_6 - q2_6 * 0.66616064422990773) / 550.0;
+	imag = (q2_6 * 0.74580828372926666) / 550.0;
+	level[6] = sqrt(real * real + imag * imag);
+	real = (q1_7 - q2_7 * 0.59731095851287919) / 550.0;
+	imag = (q2_7 * 0.80200973737257419) / 550.0;
+	level[7] = sqrt(real * real + imag * imag);
+}
+
+//=======================================
+//
+// 16000 Hz : width 1600
+//
+//=======================================
+static void kernel_16000(const s16 *buf, int stride, double *level)
+{
+	double q1_0 = 0, q2_0 = 0;
+	double q1_1 = 0, q2_1 = 0;
+	double q1_2 = 0, q2_2 = 0;
+	double q1_3 = 0, q2_3 = 0;
+	double q1_4 = 0, q2_4 = 0;
+	double q1_5 = 0, q2_5 = 0;
+	double q1_6 = 0, q2_6 = 0;
+	double q1_7 = 0, q2_7 = 0;
+	double q0, real, imag;
+	int i;
+
+	for (i = 0; i < 1600; i += 2, buf += stride * 2) {
+		q0 = 1.9255487034476437 * q1_0 - q2_0 + buf[0];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9092619087075822 * q1_1 - q2_1 + buf[0];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.8890968699002231 * q1_2 - q2_2 + buf[0];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.8649945223083568 * q1_3 - q2_3 + buf[0];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.7787928555701285 * q1_4 - q2_4 + buf[0];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.731002660506038 * q1_5 - q2_5 + buf[0];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.6729071669481952 * q1_6 - q2_6 + buf[0];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.6026642526665409 * q1_7 - q2_7 + buf[0];
+		q2_7 = q1_7;
+		q1_7 = q0;
+		q0 = 1.9255487034476437 * q1_0 - q2_0 + buf[stride];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9092619087075822 * q1_1 - q2_1 + buf[stride];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.8890968699002231 * q1_2 - q2_2 + buf[stride];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.8649945223083568 * q1_3 - q2_3 + buf[stride];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.7787928555701285 * q1_4 - q2_4 + buf[stride];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.731002660506038 * q1_5 - q2_5 + buf[stride];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.6729071669481952 * q1_6 - q2_6 + buf[stride];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.6026642526665409 * q1_7 - q2_7 + buf[stride];
+		q2_7 = q1_7;
+		q1_7 = q0;
+	}
+
+	real = (q1_0 - q2_0 * 0.96277435172382186) / 800.0;
+	imag = (q2_0 * 0.27030639589690547) / 800.0;
+	level[0] = sqrt(real * real + imag * imag);
+	real = (q1_1 - q2_1 * 0.95463095435379108) / 800.0;
+	imag = (q2_1 * 0.2977914387445853) / 800.0;
+	level[1] = sqrt(real * real + imag * imag);
+	real = (q1_2 - q2_2 * 0.94454843495011154) / 800.0;
+	imag = (q2_2 * 0.32837212736968857) / 800.0;
+	level[2] = sqrt(real * real + imag * imag);
+	real = (q1_3 - q2_3 * 0.93249726115417841) / 800.0;
+	imag = (q2_3 * 0.36117704514539134) / 800.0;
+	level[3] = sqrt(real * real + imag * imag);
+	real = (q1_4 - q2_4 * 0.88939642778506423) / 800.0;
+	imag = (q2_4 * 0.45713673473389455) / 800.0;
+	level[4] = sqrt(real * real + imag * imag);
+	real = (q1_5 - q2_5 * 0.86550133025301901) / 800.0;
+	imag = (q2_5 * 0.50090662536070985) / 800.0;
+	level[5] = sqrt(real * real + imag * imag);
+	real = (q1_6 - q2_6 * 0.8364535834740976) / 800.0;
+	imag = (q2_6 * 0.54803777487810179) / 800.0;
+	level[6] = sqrt(real * real + imag * imag);
+	real = (q1_7 - q2_7 * 0.80133212633327044) / 800.0;
+	imag = (q2_7 * 0.59821971156607634) / 800.0;
+	level[7] = sqrt(real * real + imag * imag);
+}
+
+//=======================================
+//
+// 22050 Hz : width 2200
+//
+//=======================================
+static void kernel_22050(const s16 *buf, int stride, double *level)
+{
+	double q1_0 = 0, q2_0 = 0;
+	double q1_1 = 0, q2_1 = 0;
+	double q1_2 = 0, q2_2 = 0;
+	double q1_3 = 0, q2_3 = 0;
+	double q1_4 = 0, q2_4 = 0;
+	double q1_5 = 0, q2_5 = 0;
+	double q1_6 = 0, q2_6 = 0;
+	double q1_7 = 0, q2_7 = 0;
+	double q0, real, imag;
+	int i;
+
+	for (i = 0; i < 2200; i += 2, buf += stride * 2) {
+		q0 = 1.960683031867539 * q1_0 - q2_0 + buf[0];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9520508422072489 * q1_1 - q2_1 + buf[0];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9413473656271243 * q1_2 - q2_2 + buf[0];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9285309301612028 * q1_3 - q2_3 + buf[0];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.8824843930697368 * q1_4 - q2_4 + buf[0];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.8568128785035245 * q1_5 - q2_5 + buf[0];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.8254646774067735 * q1_6 - q2_6 + buf[0];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.7873505299816705 * q1_7 - q2_7 + buf[0];
+		q2_7 = q1_7;
+		q1_7 = q0;
+		q0 = 1.960683031867539 * q1_0 - q2_0 + buf[stride];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9520508422072489 * q1_1 - q2_1 + buf[stride];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9413473656271243 * q1_2 - q2_2 + buf[stride];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9285309301612028 * q1_3 - q2_3 + buf[stride];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.8824843930697368 * q1_4 - q2_4 + buf[stride];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.8568128785035245 * q1_5 - q2_5 + buf[stride];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.8254646774067735 * q1_6 - q2_6 + buf[stride];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.7873505299816705 * q1_7 - q2_7 + buf[stride];
+		q2_7 = q1_7;
+		q1_7 = q0;
+	}
+
+	real = (q1_0 - q2_0 * 0.9803415159337695) / 1100.0;
+	imag = (q2_0 * 0.1973081654080204) / 1100.0;
+	level[0] = sqrt(real * real + imag * imag);
+	real = (q1_1 - q2_1 * 0.97602542110362445) / 1100.0;
+	imag = (q2_1 * 0.21765655827356231) / 1100.0;
+	level[1] = sqrt(real * real + imag * imag);
+	real = (q1_2 - q2_2 * 0.97067368281356214) / 1100.0;
+	imag = (q2_2 * 0.24040091824524346) / 1100.0;
+	level[2] = sqrt(real * real + imag * imag);
+	real = (q1_3 - q2_3 * 0.9642654650806014) / 1100.0;
+	imag = (q2_3 * 0.26493794151251987) / 1100.0;
+	level[3] = sqrt(real * real + imag * imag);
+	real = (q1_4 - q2_4 * 0.9412421965348684) / 1100.0;
+	imag = (q2_4 * 0.33773233108812106) / 1100.0;
+	level[4] = sqrt(real * real + imag * imag);
+	real = (q1_5 - q2_5 * 0.92840643925176225) / 1100.0;
+	imag = (q2_5 * 0.37156625728914616) / 1100.0;
+	level[5] = sqrt(real * real + imag * imag);
+	real = (q1_6 - q2_6 * 0.91273233870338677) / 1100.0;
+	imag = (q2_6 * 0.40855804714268712) / 1100.0;
+	level[6] = sqrt(real * real + imag * imag);
+	real = (q1_7 - q2_7 * 0.89367526499083527) / 1100.0;
+	imag = (q2_7 * 0.44871429745837205) / 1100.0;
+	level[7] = sqrt(real * real + imag * imag);
+}
+
+//=======================================
+//
+// 32000 Hz : width 3200
+//
+//=======================================
+static void kernel_32000(const s16 *buf, int stride, double *level)
+{
+	double q1_0 = 0, q2_0 = 0;
+	double q1_1 = 0, q2_1 = 0;
+	double q1_2 = 0, q2_2 = 0;
+	double q1_3 = 0, q2_3 = 0;
+	double q1_4 = 0, q2_4 = 0;
+	double q1_5 = 0, q2_5 = 0;
+	double q1_6 = 0, q2_6 = 0;
+	double q1_7 = 0, q2_7 = 0;
+	double q0, real, imag;
+	int i;
+
+	for (i = 0; i < 3200; i += 2, buf += stride * 2) {
+		q0 = 1.981299751034064 * q1_0 - q2_0 + buf[0];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9771853501145467 * q1_1 - q2_1 + buf[0];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9720793264724985 * q1_2 - q2_2 + buf[0];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9659589319994344 * q1_3 - q2_3 + buf[0];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9439117406842648 * q1_4 - q2_4 + buf[0];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.931580353106243 * q1_5 - q2_5 + buf[0];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9164830202608618 * q1_6 - q2_6 + buf[0];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.8980685584737294 * q1_7 - q2_7 + buf[0];
+		q2_7 = q1_7;
+		q1_7 = q0;
+		q0 = 1.981299751034064 * q1_0 - q2_0 + buf[stride];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9771853501145467 * q1_1 - q2_1 + buf[stride];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9720793264724985 * q1_2 - q2_2 + buf[stride];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9659589319994344 * q1_3 - q2_3 + buf[stride];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9439117406842648 * q1_4 - q2_4 + buf[stride];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.931580353106243 * q1_5 - q2_5 + buf[stride];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9164830202608618 * q1_6 - q2_6 + buf[stride];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.8980685584737294 * q1_7 - q2_7 + buf[stride];
+		q2_7 = q1_7;
+		q1_7 = q0;
+	}
+
+	real = (q1_0 - q2_0 * 0.99064987551703199) / 1600.0;
+	imag = (q2_0 * 0.13642882444003201) / 1600.0;
+	level[0] = sqrt(real * real + imag * imag);
+	real = (q1_1 - q2_1 * 0.98859267505727333) / 1600.0;
+	imag = (q2_1 * 0.15061382015971997) / 1600.0;
+	level[1] = sqrt(real * real + imag * imag);
+	real = (q1_2 - q2_2 * 0.98603966323624925) / 1600.0;
+	imag = (q2_2 * 0.16651060784509869) / 1600.0;
+	level[2] = sqrt(real * real + imag * imag);
+	real = (q1_3 - q2_3 * 0.98297946599971719) / 1600.0;
+	imag = (q2_3 * 0.18371545776801365) / 1600.0;
+	level[3] = sqrt(real * real + imag * imag);
+	real = (q1_4 - q2_4 * 0.97195587034213238) / 1600.0;
+	imag = (q2_4 * 0.23516331794620499) / 1600.0;
+	level[4] = sqrt(real * real + imag * imag);
+	real = (q1_5 - q2_5 * 0.96579017655312149) / 1600.0;
+	imag = (q2_5 * 0.25932476718102054) / 1600.0;
+	level[5] = sqrt(real * real + imag * imag);
+	real = (q1_6 - q2_6 * 0.95824151013043091) / 1600.0;
+	imag = (q2_6 * 0.28596015152980886) / 1600.0;
+	level[6] = sqrt(real * real + imag * imag);
+	real = (q1_7 - q2_7 * 0.94903427923686468) / 1600.0;
+	imag = (q2_7 * 0.3151728681745381) / 1600.0;
+	level[7] = sqrt(real * real + imag * imag);
+}
+
+//=======================================
+//
+// 44100 Hz : width 4410
+//
+//=======================================
+static void kernel_44100(const s16 *buf, int stride, double *level)
+{
+	double q1_0 = 0, q2_0 = 0;
+	double q1_1 = 0, q2_1 = 0;
+	double q1_2 = 0, q2_2 = 0;
+	double q1_3 = 0, q2_3 = 0;
+	double q1_4 = 0, q2_4 = 0;
+	double q1_5 = 0, q2_5 = 0;
+	double q1_6 = 0, q2_6 = 0;
+	double q1_7 = 0, q2_7 = 0;
+	double q0, real, imag;
+	int i;
+
+	for (i = 0; i < 4410; i += 2, buf += stride * 2) {
+		q0 = 1.9901464850275568 * q1_0 - q2_0 + buf[0];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9879765698335705 * q1_1 - q2_1 + buf[0];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9852826916152582 * q1_2 - q2_2 + buf[0];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.982052201674114 * q1_3 - q2_3 + buf[0];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9704020891863003 * q1_4 - q2_4 + buf[0];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.9638770018775424 * q1_5 - q2_5 + buf[0];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9558795150537196 * q1_6 - q2_6 + buf[0];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.946111643760879 * q1_7 - q2_7 + buf[0];
+		q2_7 = q1_7;
+		q1_7 = q0;
+		q0 = 1.9901464850275568 * q1_0 - q2_0 + buf[stride];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9879765698335705 * q1_1 - q2_1 + buf[stride];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9852826916152582 * q1_2 - q2_2 + buf[stride];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.982052201674114 * q1_3 - q2_3 + buf[stride];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9704020891863003 * q1_4 - q2_4 + buf[stride];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.9638770018775424 * q1_5 - q2_5 + buf[stride];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9558795150537196 * q1_6 - q2_6 + buf[stride];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.946111643760879 * q1_7 - q2_7 + buf[stride];
+		q2_7 = q1_7;
+		q1_7 = q0;
+	}
+
+	real = (q1_0 - q2_0 * 0.99507324251377838) / 2205.0;
+	imag = (q2_0 * 0.099142533925229315) / 2205.0;
+	level[0] = sqrt(real * real + imag * imag);
+	real = (q1_1 - q2_1 * 0.99398828491678526) / 2205.0;
+	imag = (q2_1 * 0.10948648066399701) / 2205.0;
+	level[1] = sqrt(real * real + imag * imag);
+	real = (q1_2 - q2_2 * 0.99264134580762908) / 2205.0;
+	imag = (q2_2 * 0.12109152981616404) / 2205.0;
+	level[2] = sqrt(real * real + imag * imag);
+	real = (q1_3 - q2_3 * 0.991026100837057) / 2205.0;
+	imag = (q2_3 * 0.13366849838200204) / 2205.0;
+	level[3] = sqrt(real * real + imag * imag);
+	real = (q1_4 - q2_4 * 0.98520104459315017) / 2205.0;
+	imag = (q2_4 * 0.17140274715583123) / 2205.0;
+	level[4] = sqrt(real * real + imag * imag);
+	real = (q1_5 - q2_5 * 0.98193850093877122) / 2205.0;
+	imag = (q2_5 * 0.18920037096718098) / 2205.0;
+	level[5] = sqrt(real * real + imag * imag);
+	real = (q1_6 - q2_6 * 0.9779397575268598) / 2205.0;
+	imag = (q2_6 * 0.20888712418027744) / 2205.0;
+	level[6] = sqrt(real * real + imag * imag);
+	real = (q1_7 - q2_7 * 0.97305582188043949) / 2205.0;
+	imag = (q2_7 * 0.23056965868167126) / 2205.0;
+	level[7] = sqrt(real * real + imag * imag);
+}
+
+//=======================================
+//
+// 48000 Hz : width 4800
+//
+//=======================================
+static void kernel_48000(const s16 *buf, int stride, double *level)
+{
+	double q1_0 = 0, q2_0 = 0;
+	double q1_1 = 0, q2_1 = 0;
+	double q1_2 = 0, q2_2 = 0;
+	double q1_3 = 0, q2_3 = 0;
+	double q1_4 = 0, q2_4 = 0;
+	double q1_5 = 0, q2_5 = 0;
+	double q1_6 = 0, q2_6 = 0;
+	double q1_7 = 0, q2_7 = 0;
+	double q0, real, imag;
+	int i;
+
+	for (i = 0; i < 4800; i += 2, buf += stride * 2) {
+		q0 = 1.9916815667850887 * q1_0 - q2_0 + buf[0];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9898494164993203 * q1_1 - q2_1 + buf[0];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9875747180467069 * q1_2 - q2_2 + buf[0];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9848466962400604 * q1_3 - q2_3 + buf[0];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9750067204254866 * q1_4 - q2_4 + buf[0];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.9694941567334254 * q1_5 - q2_5 + buf[0];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9627363830518667 * q1_6 - q2_6 + buf[0];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.9544807270597335 * q1_7 - q2_7 + buf[0];
+		q2_7 = q1_7;
+		q1_7 = q0;
+		q0 = 1.9916815667850887 * q1_0 - q2_0 + buf[stride];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9898494164993203 * q1_1 - q2_1 + buf[stride];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9875747180467069 * q1_2 - q2_2 + buf[stride];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9848466962400604 * q1_3 - q2_3 + buf[stride];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9750067204254866 * q1_4 - q2_4 + buf[stride];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.9694941567334254 * q1_5 - q2_5 + buf[stride];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9627363830518667 * q1_6 - q2_6 + buf[stride];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.9544807270597335 * q1_7 - q2_7 + buf[stride];
+		q2_7 = q1_7;
+		q1_7 = q0;
+	}
+
+	real = (q1_0 - q2_0 * 0.99584078339254434) / 2400.0;
+	imag = (q2_0 * 0.091110559937493854) / 2400.0;
+	level[0] = sqrt(real * real + imag * imag);
+	real = (q1_1 - q2_1 * 0.99492470824966017) / 2400.0;
+	imag = (q2_1 * 0.10062218897603353) / 2400.0;
+	level[1] = sqrt(real * real + imag * imag);
+	real = (q1_2 - q2_2 * 0.99378735902335347) / 2400.0;
+	imag = (q2_2 * 0.11129548528753667) / 2400.0;
+	level[2] = sqrt(real * real + imag * imag);
+	real = (q1_3 - q2_3 * 0.99242334812003019) / 2400.0;
+	imag = (q2_3 * 0.12286536577176398) / 2400.0;
+	level[3] = sqrt(real * real + imag * imag);
+	real = (q1_4 - q2_4 * 0.98750336021274332) / 2400.0;
+	imag = (q2_4 * 0.15759794912542807) / 2400.0;
+	level[4] = sqrt(real * real + imag * imag);
+	real = (q1_5 - q2_5 * 0.98474707836671271) / 2400.0;
+	imag = (q2_5 * 0.17399192983648201) / 2400.0;
+	level[5] = sqrt(real * real + imag * imag);
+	real = (q1_6 - q2_6 * 0.98136819152593335) / 2400.0;
+	imag = (q2_6 * 0.19213659896313104) / 2400.0;
+	level[6] = sqrt(real * real + imag * imag);
+	real = (q1_7 - q2_7 * 0.97724036352986676) / 2400.0;
+	imag = (q2_7 * 0.21213503220357993) / 2400.0;
+	level[7] = sqrt(real * real + imag * imag);
+}
+
+//=======================================
+//
+// 64000 Hz : width 6400
+//
+//=======================================
+static void kernel_64000(const s16 *buf, int stride, double *level)
+{
+	double q1_0 = 0, q2_0 = 0;
+	double q1_1 = 0, q2_1 = 0;
+	double q1_2 = 0, q2_2 = 0;
+	double q1_3 = 0, q2_3 = 0;
+	double q1_4 = 0, q2_4 = 0;
+	double q1_5 = 0, q2_5 = 0;
+	double q1_6 = 0, q2_6 = 0;
+	double q1_7 = 0, q2_7 = 0;
+	double q0, real, imag;
+	int i;
+
+	for (i = 0; i < 6400; i += 2, buf += stride * 2) {
+		q0 = 1.9953194608969422 * q1_0 - q2_0 + buf[0];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9942881813104512 * q1_1 - q2_1 + buf[0];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.993007608232467 * q1_2 - q2_2 + buf[0];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9914715493823743 * q1_3 - q2_3 + buf[0];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9859284329210518 * q1_4 - q2_4 + buf[0];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.9828213114414124 * q1_5 - q2_5 + buf[0];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9790106165103971 * q1_6 - q2_6 + buf[0];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.9743526935362206 * q1_7 - q2_7 + buf[0];
+		q2_7 = q1_7;
+		q1_7 = q0;
+		q0 = 1.9953194608969422 * q1_0 - q2_0 + buf[stride];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9942881813104512 * q1_1 - q2_1 + buf[stride];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.993007608232467 * q1_2 - q2_2 + buf[stride];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9914715493823743 * q1_3 - q2_3 + buf[stride];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9859284329210518 * q1_4 - q2_4 + buf[stride];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.9828213114414124 * q1_5 - q2_5 + buf[stride];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9790106165103971 * q1_6 - q2_6 + buf[stride];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.9743526935362206 * q1_7 - q2_7 + buf[stride];
+		q2_7 = q1_7;
+		q1_7 = q0;
+	}
+
+	real = (q1_0 - q2_0 * 0.99765973044847112) / 3200.0;
+	imag = (q2_0 * 0.06837442680918078) / 3200.0;
+	level[0] = sqrt(real * real + imag * imag);
+	real = (q1_1 - q2_1 * 0.99714409065522558) / 3200.0;
+	imag = (q2_1 * 0.075522595766852163) / 3200.0;
+	level[1] = sqrt(real * real + imag * imag);
+	real = (q1_2 - q2_2 * 0.99650380411623352) / 3200.0;
+	imag = (q2_2 * 0.083547402005540505) / 3200.0;
+	level[2] = sqrt(real * real + imag * imag);
+	real = (q1_3 - q2_3 * 0.99573577469118713) / 3200.0;
+	imag = (q2_3 * 0.092251108395191642) / 3200.0;
+	level[3] = sqrt(real * real + imag * imag);
+	real = (q1_4 - q2_4 * 0.99296421646052591) / 3200.0;
+	imag = (q2_4 * 0.11841479987287822) / 3200.0;
+	level[4] = sqrt(real * real + imag * imag);
+	real = (q1_5 - q2_5 * 0.99141065572070619) / 3200.0;
+	imag = (q2_5 * 0.13078574740176882) / 3200.0;
+	level[5] = sqrt(real * real + imag * imag);
+	real = (q1_6 - q2_6 * 0.98950530825519856) / 3200.0;
+	imag = (q2_6 * 0.14449652222383946) / 3200.0;
+	level[6] = sqrt(real * real + imag * imag);
+	real = (q1_7 - q2_7 * 0.98717634676811028) / 3200.0;
+	imag = (q2_7 * 0.15963351897883998) / 3200.0;
+	level[7] = sqrt(real * real + imag * imag);
+}
+
+//=======================================
+//
+// 88200 Hz : width 8820
+//
+//=======================================
+static void kernel_88200(const s16 *buf, int stride, double *level)
+{
+	double q1_0 = 0, q2_0 = 0;
+	double q1_1 = 0, q2_1 = 0;
+	double q1_2 = 0, q2_2 = 0;
+	double q1_3 = 0, q2_3 = 0;
+	double q1_4 = 0, q2_4 = 0;
+	double q1_5 = 0, q2_5 = 0;
+	double q1_6 = 0, q2_6 = 0;
+	double q1_7 = 0, q2_7 = 0;
+	double q0, real, imag;
+	int i;
+
+	for (i = 0; i < 8820; i += 2, buf += stride * 2) {
+		q0 = 1.9975351023267542 * q1_0 - q2_0 + buf[0];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9969918802623035 * q1_1 - q2_1 + buf[0];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9963172823014026 * q1_2 - q2_2 + buf[0];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9955080059158155 * q1_3 - q2_3 + buf[0];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9925867833513049 * q1_4 - q2_4 + buf[0];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.9909487692749761 * q1_5 - q2_5 + buf[0];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9889392939588979 * q1_6 - q2_6 + buf[0];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.9864822284029824 * q1_7 - q2_7 + buf[0];
+		q2_7 = q1_7;
+		q1_7 = q0;
+		q0 = 1.9975351023267542 * q1_0 - q2_0 + buf[stride];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9969918802623035 * q1_1 - q2_1 + buf[stride];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9963172823014026 * q1_2 - q2_2 + buf[stride];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9955080059158155 * q1_3 - q2_3 + buf[stride];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9925867833513049 * q1_4 - q2_4 + buf[stride];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.9909487692749761 * q1_5 - q2_5 + buf[stride];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9889392939588979 * q1_6 - q2_6 + buf[stride];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.9864822284029824 * q1_7 - q2_7 + buf[stride];
+		q2_7 = q1_7;
+		q1_7 = q0;
+	}
+
+	real = (q1_0 - q2_0 * 0.99876755116337712) / 4410.0;
+	imag = (q2_0 * 0.049632436401115969) / 4410.0;
+	level[0] = sqrt(real * real + imag * imag);
+	real = (q1_1 - q2_1 * 0.99849594013115173) / 4410.0;
+	imag = (q2_1 * 0.054825701469360021) / 4410.0;
+	level[1] = sqrt(real * real + imag * imag);
+	real = (q1_2 - q2_2 * 0.9981586411507013) / 4410.0;
+	imag = (q2_2 * 0.060657457053403266) / 4410.0;
+	level[2] = sqrt(real * real + imag * imag);
+	real = (q1_3 - q2_3 * 0.99775400295790773) / 4410.0;
+	imag = (q2_3 * 0.06698469662147831) / 4410.0;
+	level[3] = sqrt(real * real + imag * imag);
+	real = (q1_4 - q2_4 * 0.99629339167565245) / 4410.0;
+	imag = (q2_4 * 0.086020216829678683) / 4410.0;
+	level[4] = sqrt(real * real + imag * imag);
+	real = (q1_5 - q2_5 * 0.99547438463748805) / 4410.0;
+	imag = (q2_5 * 0.095030255869456737) / 4410.0;
+	level[5] = sqrt(real * real + imag * imag);
+	real = (q1_6 - q2_6 * 0.99446964697944895) / 4410.0;
+	imag = (q2_6 * 0.10502438400947703) / 4410.0;
+	level[6] = sqrt(real * real + imag * imag);
+	real = (q1_7 - q2_7 * 0.99324111420149119) / 4410.0;
+	imag = (q2_7 * 0.11606932867808034) / 4410.0;
+	level[7] = sqrt(real * real + imag * imag);
+}
+
+//=======================================
+//
+// 96000 Hz : width 9600
+//
+//=======================================
+static void kernel_96000(const s16 *buf, int stride, double *level)
+{
+	double q1_0 = 0, q2_0 = 0;
+	double q1_1 = 0, q2_1 = 0;
+	double q1_2 = 0, q2_2 = 0;
+	double q1_3 = 0, q2_3 = 0;
+	double q1_4 = 0, q2_4 = 0;
+	double q1_5 = 0, q2_5 = 0;
+	double q1_6 = 0, q2_6 = 0;
+	double q1_7 = 0, q2_7 = 0;
+	double q0, real, imag;
+	int i;
+
+	for (i = 0; i < 9600; i += 2, buf += stride * 2) {
+		q0 = 1.997919309377906 * q1_0 - q2_0 + buf[0];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9974607421672448 * q1_1 - q2_1 + buf[0];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9968912634509439 * q1_2 - q2_2 + buf[0];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9962080793945456 * q1_3 - q2_3 + buf[0];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9937418891184202 * q1_4 - q2_4 + buf[0];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.9923589427443604 * q1_5 - q2_5 + buf[0];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9906622975913988 * q1_6 - q2_6 + buf[0];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.9885876211672779 * q1_7 - q2_7 + buf[0];
+		q2_7 = q1_7;
+		q1_7 = q0;
+		q0 = 1.997919309377906 * q1_0 - q2_0 + buf[stride];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9974607421672448 * q1_1 - q2_1 + buf[stride];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9968912634509439 * q1_2 - q2_2 + buf[stride];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9962080793945456 * q1_3 - q2_3 + buf[stride];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9937418891184202 * q1_4 - q2_4 + buf[stride];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.9923589427443604 * q1_5 - q2_5 + buf[stride];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9906622975913988 * q1_6 - q2_6 + buf[stride];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.9885876211672779 * q1_7 - q2_7 + buf[stride];
+		q2_7 = q1_7;
+		q1_7 = q0;
+	}
+
+	real = (q1_0 - q2_0 * 0.99895965468895298) / 4800.0;
+	imag = (q2_0 * 0.045602722547320014) / 4800.0;
+	level[0] = sqrt(real * real + imag * imag);
+	real = (q1_1 - q2_1 * 0.99873037108362239) / 4800.0;
+	imag = (q2_1 * 0.050375052110840722) / 4800.0;
+	level[1] = sqrt(real * real + imag * imag);
+	real = (q1_2 - q2_2 * 0.99844563172547196) / 4800.0;
+	imag = (q2_2 * 0.055734374387116335) / 4800.0;
+	level[2] = sqrt(real * real + imag * imag);
+	real = (q1_3 - q2_3 * 0.99810403969727279) / 4800.0;
+	imag = (q2_3 * 0.061549378063347641) / 4800.0;
+	level[3] = sqrt(real * real + imag * imag);
+	real = (q1_4 - q2_4 * 0.9968709445592101) / 4800.0;
+	imag = (q2_4 * 0.079046314864314612) / 4800.0;
+	level[4] = sqrt(real * real + imag * imag);
+	real = (q1_5 - q2_5 * 0.99617947137218021) / 4800.0;
+	imag = (q2_5 * 0.0873296101940437) / 4800.0;
+	level[5] = sqrt(real * real + imag * imag);
+	real = (q1_6 - q2_6 * 0.99533114879569939) / 4800.0;
+	imag = (q2_6 * 0.096518932013534717) / 4800.0;
+	level[6] = sqrt(real * real + imag * imag);
+	real = (q1_7 - q2_7 * 0.99429381058363897) / 4800.0;
+	imag = (q2_7 * 0.10667623088142282) / 4800.0;
+	level[7] = sqrt(real * real + imag * imag);
+}
+
+//=======================================
+//
+// 176400 Hz : width 17640
+//
+//=======================================
+static void kernel_176400(const s16 *buf, int stride, double *level)
+{
+	double q1_0 = 0, q2_0 = 0;
+	double q1_1 = 0, q2_1 = 0;
+	double q1_2 = 0, q2_2 = 0;
+	double q1_3 = 0, q2_3 = 0;
+	double q1_4 = 0, q2_4 = 0;
+	double q1_5 = 0, q2_5 = 0;
+	double q1_6 = 0, q2_6 = 0;
+	double q1_7 = 0, q2_7 = 0;
+	double q0, real, imag;
+	int i;
+
+	for (i = 0; i < 17640; i += 2, buf += stride * 2) {
+		q0 = 1.9993836806192937 * q1_0 - q2_0 + buf[0];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9992478286251316 * q1_1 - q2_1 + buf[0];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9990791085650919 * q1_2 - q2_2 + buf[0];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9988766860203797 * q1_3 - q2_3 + buf[0];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9981458363571225 * q1_4 - q2_4 + buf[0];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.9977359107937607 * q1_5 - q2_5 + buf[0];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9972329092919778 * q1_6 - q2_6 + buf[0];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.9966176971075316 * q1_7 - q2_7 + buf[0];
+		q2_7 = q1_7;
+		q1_7 = q0;
+		q0 = 1.9993836806192937 * q1_0 - q2_0 + buf[stride];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9992478286251316 * q1_1 - q2_1 + buf[stride];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9990791085650919 * q1_2 - q2_2 + buf[stride];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9988766860203797 * q1_3 - q2_3 + buf[stride];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9981458363571225 * q1_4 - q2_4 + buf[stride];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.9977359107937607 * q1_5 - q2_5 + buf[stride];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9972329092919778 * q1_6 - q2_6 + buf[stride];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.9966176971075316 * q1_7 - q2_7 + buf[stride];
+		q2_7 = q1_7;
+		q1_7 = q0;
+	}
+
+	real = (q1_0 - q2_0 * 0.99969184030964686) / 8820.0;
+	imag = (q2_0 * 0.024823867916008348) / 8820.0;
+	level[0] = sqrt(real * real + imag * imag);
+	real = (q1_1 - q2_1 * 0.99962391431256581) / 8820.0;
+	imag = (q2_1 * 0.027423164194237622) / 8820.0;
+	level[1] = sqrt(real * real + imag * imag);
+	real = (q1_2 - q2_2 * 0.99953955428254593) / 8820.0;
+	imag = (q2_2 * 0.030342699692831189) / 8820.0;
+	level[2] = sqrt(real * real + imag * imag);
+	real = (q1_3 - q2_3 * 0.99943834301018986) / 8820.0;
+	imag = (q2_3 * 0.033511170093658976) / 8820.0;
+	level[3] = sqrt(real * real + imag * imag);
+	real = (q1_4 - q2_4 * 0.99907291817856125) / 8820.0;
+	imag = (q2_4 * 0.043050019305149734) / 8820.0;
+	level[4] = sqrt(real * real + imag * imag);
+	real = (q1_5 - q2_5 * 0.99886795539688034) / 8820.0;
+	imag = (q2_5 * 0.047568978139707341) / 8820.0;
+	level[5] = sqrt(real * real + imag * imag);
+	real = (q1_6 - q2_6 * 0.99861645464598892) / 8820.0;
+	imag = (q2_6 * 0.052584945662000102) / 8820.0;
+	level[6] = sqrt(real * real + imag * imag);
+	real = (q1_7 - q2_7 * 0.99830884855376578) / 8820.0;
+	imag = (q2_7 * 0.058132976005485754) / 8820.0;
+	level[7] = sqrt(real * real + imag * imag);
+}
+
+//=======================================
+//
+// 192000 Hz : width 19200
+//
+//=======================================
+static void kernel_192000(const s16 *buf, int stride, double *level)
+{
+	double q1_0 = 0, q2_0 = 0;
+	double q1_1 = 0, q2_1 = 0;
+	double q1_2 = 0, q2_2 = 0;
+	double q1_3 = 0, q2_3 = 0;
+	double q1_4 = 0, q2_4 = 0;
+	double q1_5 = 0, q2_5 = 0;
+	double q1_6 = 0, q2_6 = 0;
+	double q1_7 = 0, q2_7 = 0;
+	double q0, real, imag;
+	int i;
+
+	for (i = 0; i < 19200; i += 2, buf += stride * 2) {
+		q0 = 1.9994797596819793 * q1_0 - q2_0 + buf[0];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9993650847624715 * q1_1 - q2_1 + buf[0];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9992226648002327 * q1_2 - q2_2 + buf[0];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9990517950754916 * q1_3 - q2_3 + buf[0];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9984348598636934 * q1_4 - q2_4 + buf[0];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.9980888225362656 * q1_5 - q2_5 + buf[0];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9976642104196087 * q1_6 - q2_6 + buf[0];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.9971448673462018 * q1_7 - q2_7 + buf[0];
+		q2_7 = q1_7;
+		q1_7 = q0;
+		q0 = 1.9994797596819793 * q1_0 - q2_0 + buf[stride];
+		q2_0 = q1_0;
+		q1_0 = q0;
+		q0 = 1.9993650847624715 * q1_1 - q2_1 + buf[stride];
+		q2_1 = q1_1;
+		q1_1 = q0;
+		q0 = 1.9992226648002327 * q1_2 - q2_2 + buf[stride];
+		q2_2 = q1_2;
+		q1_2 = q0;
+		q0 = 1.9990517950754916 * q1_3 - q2_3 + buf[stride];
+		q2_3 = q1_3;
+		q1_3 = q0;
+		q0 = 1.9984348598636934 * q1_4 - q2_4 + buf[stride];
+		q2_4 = q1_4;
+		q1_4 = q0;
+		q0 = 1.9980888225362656 * q1_5 - q2_5 + buf[stride];
+		q2_5 = q1_5;
+		q1_5 = q0;
+		q0 = 1.9976642104196087 * q1_6 - q2_6 + buf[stride];
+		q2_6 = q1_6;
+		q1_6 = q0;
+		q0 = 1.9971448673462018 * q1_7 - q2_7 + buf[stride];
+		q2_7 = q1_7;
+		q1_7 = q0;
+	}
+
+	real = (q1_0 - q2_0 * 0.99973987984098966) / 9600.0;
+	imag = (q2_0 * 0.022807293910578622) / 9600.0;
+	level[0] = sqrt(real * real + imag * imag);
+	real = (q1_1 - q2_1 * 0.99968254238123577) / 9600.0;
+	imag = (q2_1 * 0.025195524566652805) / 9600.0;
+	level[1] = sqrt(real * real + imag * imag);
+	real = (q1_2 - q2_2 * 0.99961133240011635) / 9600.0;
+	imag = (q2_2 * 0.027878022477644055) / 9600.0;
+	level[2] = sqrt(real * real + imag * imag);
+	real = (q1_3 - q2_3 * 0.99952589753774579) / 9600.0;
+	imag = (q2_3 * 0.03078928630812355) / 9600.0;
+	level[3] = sqrt(real * real + imag * imag);
+	real = (q1_4 - q2_4 * 0.9992174299318467) / 9600.0;
+	imag = (q2_4 * 0.039554111295729749) / 9600.0;
+	level[4] = sqrt(real * real + imag * imag);
+	real = (q1_5 - q2_5 * 0.99904441126813281) / 9600.0;
+	imag = (q2_5 * 0.043706570603399011) / 9600.0;
+	level[5] = sqrt(real * real + imag * imag);
+	real = (q1_6 - q2_6 * 0.99883210520980437) / 9600.0;
+	imag = (q2_6 * 0.048315893887522242) / 9600.0;
+	level[6] = sqrt(real * real + imag * imag);
+	real = (q1_7 - q2_7 * 0.99857243367310089) / 9600.0;
+	imag = (q2_7 * 0.053414367993832) / 9600.0;
+	level[7] = sqrt(real * real + imag * imag);
+}
+
+static const struct {
+	int rate;
+	int width;
+	dtmf_kernel kernel;
+} kernel_table[] = {
+	{   8000,   800, kernel_8000 },
+	{  11025,  1100, kernel_11025 },
+	{  16000,  1600, kernel_16000 },
+	{  22050,  2200, kernel_22050 },
+	{  32000,  3200, kernel_32000 },
+	{  44100,  4410, kernel_44100 },
+	{  48000,  4800, kernel_48000 },
+	{  64000,  6400, kernel_64000 },
+	{  88200,  8820, kernel_88200 },
+	{  96000,  9600, kernel_96000 },
+	{ 176400, 17640, kernel_176400 },
+	{ 192000, 19200, kernel_192000 },
+};
+
+//=======================================
+//
+// dtmf_kernel_select
+//
+// NULL if no kernel. use generic goertzel() in such case
+//
+//=======================================
+dtmf_kernel dtmf_kernel_select(int rate, int width)
+{
+	for (int i = 0; i < ARRAY_SIZE(kernel_table); i++)
+		if (kernel_table[i].rate  == rate &&
+		    kernel_table[i].width == width)
+			return kernel_table[i].kernel;
+
+	return NULL;
+}
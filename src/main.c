@@ -7,9 +7,31 @@
 #include "param.h"
 
 #define VERSION		"1.1.1"
-#define MAX_CHAN	16
 
 #define is_versbose(param)	(param->flag & FLAG_VERBOSE)
+#define is_latency(param)	(param->flag & FLAG_LATENCY)
+#define is_xrun(param)		(param->flag & FLAG_XRUN)
+#define is_drift(param)		(param->flag & FLAG_DRIFT)
+#define is_matrix(param)	(param->flag & FLAG_MATRIX)
+#define is_memo(param)		(param->flag & FLAG_MEMO)
+
+// -d can stream 1 challenge each if no option needs all data
+#define is_stream(param)	(is_drift(param) && !is_cache(param) &&	\
+				 !is_latency(param) && !is_xrun(param))
+
+// -C is used only when the output is just the decoded string
+#define is_cache(param)		(param->cache && !param->trace &&		\
+				 !(param->flag & (FLAG_VERBOSE | FLAG_LATENCY |	\
+						  FLAG_XRUN | FLAG_DRIFT)))
+
+// options which are supported only on wav input (not pack, FLAC)
+#define is_wav_only(param)	((param)->scan || (param)->cache || (param)->trace ||	\
+				 (param)->expect ||					\
+				 ((param)->flag & (FLAG_LATENCY | FLAG_XRUN |		\
+						   FLAG_DRIFT | FLAG_MEMO)))
+
+// -L : tone onset marker position
+#define LATENCY_LEAD(rate)	((rate) / 10)	// 100ms
 
 //=======================================
 //
@@ -24,17 +46,62 @@ static void usage(void)
 		"	-o : create nums (0123456789 or _)\n"
 		"	-r : rate (default: 8000)\n"
 		"	-c : chan (default: 2)\n"
+		"	-L : latency marker (tone starts after 100ms)\n"
 		"	-v : verbose print\n\n"
-		"(input) simple_dtmf [v] -i file.wav\n\n"
-		"	-i : input file\n"
-		"	-v : verbose print\n\n"
+		"(input) simple_dtmf [vPtLxdCem] -i file.wav\n\n"
+		"	-i : input file (wav, or FLAC)\n"
+		"	-C : result cache directory\n"
+		"	-e : expected result (ex -e 12,34), exit 0 if match, 1 if not\n"
+		"	-m : memo of same challenge (-m[entries], default 1024)\n"
+		"	-L : latency measurement (tone onset)\n"
+		"	-x : xrun (tone discontinuity) detection\n"
+		"	-d : clock drift estimation (ppm)\n"
+		"	-f : frequency scan (ex -f 697,1209,2418)\n"
+		"	-t : per window level trace (CSV) file\n"
+		"	-v : verbose print\n"
+		"	-P : profile print to stderr (-Pjson : JSON)\n\n"
+		"(shm)   simple_dtmf [vP] -s /name\n\n"
+		"	-s : POSIX shared memory ring buffer input (see shm.h)\n\n"
+		"(pack)  simple_dtmf [v] -p corpus.pack file.wav ...\n"
+		"        simple_dtmf [vP] -i corpus.pack\n\n"
+		"	-p : create pack file from wav files\n"
+		"	-i : analyze all entries in pack file\n\n"
 		"(info)  simple_dtmf -l file.wav\n\n"
+		"(route) simple_dtmf -M [rcv]\n"
+		"        simple_dtmf -M -i file.wav\n\n"
+		"	-M : routing matrix signature (%s) create / analyze\n\n"
+		"(sim)   simple_dtmf [rcv] -S n=1000,snr=20,...\n\n"
+		"	-S : in-process loopback simulation\n"
+		"	     n=cases, threads=N, msec=signal length, seed=N\n"
+		"	     delay=samples, gain=dB, snr=dB, dc=offset, clip=level\n"
+		"	     resample=rate, map=out chan <- in chan (ex 1032)\n\n"
+		"(batch) simple_dtmf [vP] -a[slots] file.wav ...\n\n"
+		"	-a : analyze many files (io_uring, or pread)\n\n"
+		"(bench) simple_dtmf [v] -B[cases]\n\n"
+		"	-B : detection accuracy vs cost benchmark\n\n"
 		"note:\n"
 		"	max %d channels\n",
-		VERSION, MAX_CHAN
+		VERSION, "matrix.wav", MAX_CHAN
 		);
 }
 
+//=======================================
+//
+// set_type
+//
+// FLAG_TYPE_xxx is not bit field. 2nd mode option is error
+//
+//=======================================
+static int set_type(struct dev_param *param, int type)
+{
+	if (param->flag & FLAG_TYPE_MASK)
+		return -EINVAL;
+
+	param->flag |= type;
+
+	return 0;
+}
+
 static int parse_options(int argc, char **argv, struct dev_param *param)
 {
 	int opt;
@@ -49,29 +116,93 @@ static int parse_options(int argc, char **argv, struct dev_param *param)
 	//==========================
 	// parse
 	//==========================
-	while ((opt = getopt(argc, argv, "o:i:l:r:c:vh")) != -1) {
+	while ((opt = getopt(argc, argv, "o:i:l:r:c:t:S:f:s:C:e:p:vLxdMP::B::a::m::h")) != -1) {
 		switch (opt) {
 		case 'o':
-			param->flag	|= FLAG_TYPE_OUT;
+			if (set_type(param, FLAG_TYPE_OUT))
+				goto err;
 			param->nums	= optarg;
 			break;
 		case 'i':
-			param->flag	|= FLAG_TYPE_IN;
+			if (set_type(param, FLAG_TYPE_IN))
+				goto err;
 			param->filename	= optarg;
 			break;
 		case 'l':
-			param->flag	|= FLAG_TYPE_INFO;
+			if (set_type(param, FLAG_TYPE_INFO))
+				goto err;
+			param->filename	= optarg;
+			break;
+		case 'S':
+			if (set_type(param, FLAG_TYPE_SIM))
+				goto err;
+			param->sim	= optarg;
+			break;
+		case 's':
+			if (set_type(param, FLAG_TYPE_SHM))
+				goto err;
+			param->filename	= optarg;
+			break;
+		case 'p':
+			if (set_type(param, FLAG_TYPE_PACK))
+				goto err;
 			param->filename	= optarg;
 			break;
+		case 'B':
+			if (set_type(param, FLAG_TYPE_BENCH))
+				goto err;
+			param->bench	= optarg;
+			break;
+		case 'a':
+			if (set_type(param, FLAG_TYPE_BATCH))
+				goto err;
+			param->batch	= optarg;
+			break;
 		case 'r':
 			sscanf(optarg, "%d", &param->rate);
 			break;
 		case 'c':
 			sscanf(optarg, "%d", &param->chan);
 			break;
+		case 't':
+			param->trace	= optarg;
+			break;
+		case 'f':
+			param->scan	= optarg;
+			break;
+		case 'C':
+			param->cache	= optarg;
+			break;
+		case 'e':
+			param->expect	= optarg;
+			break;
+		case 'm':
+			param->flag	|= FLAG_MEMO;
+			param->memo	= optarg;
+			break;
 		case 'v':
 			param->flag |= FLAG_VERBOSE;
 			break;
+		case 'L':
+			param->flag |= FLAG_LATENCY;
+			break;
+		case 'x':
+			param->flag |= FLAG_XRUN;
+			break;
+		case 'd':
+			param->flag |= FLAG_DRIFT;
+			break;
+		case 'M':
+			param->flag |= FLAG_MATRIX;
+			break;
+		case 'P':
+			param->flag |= FLAG_PROFILE;
+			prof_mode = PROF_TEXT;
+			if (optarg && !strcmp(optarg, "json"))
+				prof_mode = PROF_JSON;
+			else if (optarg)
+				goto err;
+			break;
 		case 'h':
 			usage();
 			exit(0);
@@ -82,12 +213,24 @@ static int parse_options(int argc, char **argv, struct dev_param *param)
 	argc -= optind;
 	argv += optind;
 
+	// -p file list
+	param->files	= argv;
+	param->files_nr	= argc;
+
 	//==========================
 	// check params
 	//==========================
+
+	// -M only is create mode
+	if (is_matrix(param) && !(param->flag & FLAG_TYPE_MASK))
+		param->flag |= FLAG_TYPE_OUT;
+
 	switch (param->flag & FLAG_TYPE_MASK) {
 		int len;
 	case FLAG_TYPE_OUT:
+		if (is_matrix(param))
+			break;
+
 		len = strlen(param->nums);
 
 		if (len < param->chan)
@@ -99,6 +242,14 @@ static int parse_options(int argc, char **argv, struct dev_param *param)
 		break;
 	case FLAG_TYPE_IN:
 	case FLAG_TYPE_INFO:
+	case FLAG_TYPE_SIM:
+	case FLAG_TYPE_SHM:
+	case FLAG_TYPE_BENCH:
+		break;
+	case FLAG_TYPE_PACK:
+	case FLAG_TYPE_BATCH:
+		if (!param->files_nr)
+			goto err;
 		break;
 	default:
 		goto err;
@@ -138,11 +289,11 @@ err:
 // buf_free
 //
 //=======================================
-static int buf_alloc(struct dev_param *param)
+static int buf_alloc(struct dev_param *param, int num)
 {
 	s16 *buf;
 
-	buf = calloc(param->length, param->sample);
+	buf = calloc(param->length * num, param->sample);
 	if (!buf)
 		return -ENOMEM;
 
@@ -168,6 +319,7 @@ static int __dtmf_wav_write(struct dev_param *param, char *filename)
 {
 	char num;
 	int ret = -EINVAL;
+	int lead = 0;
 
 	// filename is used at wav.c
 	param->filename = filename;
@@ -186,12 +338,23 @@ static int __dtmf_wav_write(struct dev_param *param, char *filename)
 	//
 	// filename : 023.wav
 	//            ^^^
+	//
+	// tone starts after "lead" if -L.
+	// This sharp onset is the marker for latency measurement
+	//
+	//	<- lead ->
+	//	[_________xxxxxxxxxxxxx]
 	//==========================
+	if (is_latency(param)) {
+		lead = LATENCY_LEAD(param->rate);
+		memset(param->buf, 0, lead * param->sample);
+	}
+
 	for (int chan = 0; chan < param->chan; chan++) {
 		num = param->filename[chan];
 
-		ret = dtmf_fill(param->buf,
-				param->length,
+		ret = dtmf_fill(param->buf   + lead,
+				param->length - lead,
 				param->rate,
 				param->sample, num);
 		if (ret < 0)
@@ -223,7 +386,7 @@ static int dtmf_wav_write(struct dev_param *param)
 	//==========================
 	param->length = param->rate;
 
-	ret = buf_alloc(param);
+	ret = buf_alloc(param, 1);
 	if (ret < 0)
 		goto err;
 
@@ -261,27 +424,383 @@ err:
 	return ret;
 }
 
+//=======================================
+//
+// trace_open
+// trace_print
+//
+// each line is 1 challenge of 1ch
+//
+//	chan,window,697,770,852,941,1209,1336,1477,1633,low,hi,num
+//
+// low/hi are selected tone (0 if none), num is dtmf_analyze() result.
+// It can be used to check threshold in dtmf.c offline.
+//
+//=======================================
+static FILE *trace_open(struct dev_param *param)
+{
+	FILE *fp;
+
+	if (!param->trace)
+		return NULL;
+
+	fp = fopen(param->trace, "w");
+	if (!fp)
+		return NULL;
+
+	fprintf(fp, "chan,window");
+	for (int i = 0; i < DTMF_LEVELS; i++)
+		fprintf(fp, ",%d", dtmf_fq[i]);
+	fprintf(fp, ",low,hi,num\n");
+
+	return fp;
+}
+
+static void trace_print(FILE *fp, int chan, int window, struct dtmf_level *lv, char num)
+{
+	fprintf(fp, "%d,%d", chan, window);
+	for (int i = 0; i < DTMF_LEVELS; i++)
+		fprintf(fp, ",%.3f", lv->level[i]);
+	fprintf(fp, ",%d,%d,%c\n",
+		(lv->low < 0) ? 0 : lv->low,
+		(lv->hi  < 0) ? 0 : lv->hi, num);
+}
+
+//=======================================
+//
+// dtmf_wav_latency
+//
+// -L generated file has tone onset at LATENCY_LEAD().
+// Find 1st detected challenge on each channels,
+// and get sub-sample onset position around it.
+//
+//	            <-><-><->
+//	result = [?? ?? 11 11 11]
+//	                ^
+//
+//=======================================
+static int dtmf_wav_latency(struct dev_param *param, char *result,
+			    int challenge, int width)
+{
+	double onset;
+	int lead = LATENCY_LEAD(param->rate);
+	int ret;
+	int i, j;
+
+	for (i = 0; i < param->chan; i++) {
+		for (j = 0; j < challenge; j++)
+			if (result[challenge * i + j] != unknown)
+				break;
+
+		printf("ch%-2d onset   : ", i);
+		if (j == challenge) {
+			printf("-\n");
+			continue;
+		}
+
+		ret = wav_read_data(param, i);
+		if (ret < 0)
+			return ret;
+
+		onset = dtmf_onset(param->buf, param->length, param->rate,
+				   result[challenge * i + j],
+				   (j - 1) * width, (j + 3) * width, width / 4);
+		if (onset < 0) {
+			printf("-\n");
+			continue;
+		}
+
+		printf("%.2f samples (%.1f us), latency %.1f us\n",
+		       onset,
+		       onset          * 1000000 / param->rate,
+		       (onset - lead) * 1000000 / param->rate);
+	}
+
+	return 0;
+}
+
+//=======================================
+//
+// dtmf_wav_xrun
+//
+// check each same dtmf part on each channels.
+// 1st/last challenge of it are not used, because it might have
+// tone start/stop.
+// xrun might be "?" challenge. It is checked if same dtmf is around it,
+// and it is up to XRUN_BRIDGE challenges. Longer one is other tone.
+//
+//	result = [?? 11 11 11 ?? 11 11 ?? 22 22 22]
+//	                <--- check --->        <>
+//
+//=======================================
+#define XRUN_MAX	64
+#define XRUN_BRIDGE	2
+static int dtmf_wav_xrun(struct dev_param *param, char *result,
+			 int challenge, int width)
+{
+	struct dtmf_xrun xrun[XRUN_MAX];
+	int ret;
+	int i, j, k, l, nr;
+
+	for (i = 0; i < param->chan; i++) {
+		char *res = result + challenge * i;
+		int total = 0;
+
+		ret = wav_read_data(param, i);
+		if (ret < 0)
+			return ret;
+
+		for (j = 0; j < challenge; j = k) {
+			k = j + 1;
+			if (res[j] == unknown)
+				continue;
+
+			for (l = k; l < challenge; l++) {
+				if (res[l] == res[j])
+					k = l + 1;
+				else if (res[l] != unknown || l - k >= XRUN_BRIDGE)
+					break;
+			}
+
+			// [j, k) has same result (or unknown)
+			if (k - j < 3)
+				continue;
+
+			nr = dtmf_xrun(param->buf, param->length, param->rate, res[j],
+				       (j + 1) * width, (k - 1) * width, xrun, XRUN_MAX);
+
+			for (int n = 0; n < nr; n++)
+				printf("ch%-2d xrun    : %.6f sec, %s %.3f ms\n", i,
+				       (double)xrun[n].pos / param->rate,
+				       xrun[n].len ? "gap" : "drop",
+				       (double)(xrun[n].len ? xrun[n].len : xrun[n].drop) *
+				       1000 / param->rate);
+			total += nr;
+		}
+
+		if (!total)
+			printf("ch%-2d xrun    : -\n", i);
+	}
+
+	return 0;
+}
+
+//=======================================
+//
+// dtmf_wav_drift_update
+// dtmf_wav_drift
+//
+// Each channel has drift context for each tone.
+// It is updated on each detected challenge while analyzing,
+// and print ppm at the end.
+//
+// ppm is tone frequency offset, thus
+//	+ppm : capture clock is slower than playback clock
+//	-ppm : capture clock is faster than playback clock
+// rate is the capture rate which is matched to playback clock.
+//
+//=======================================
+static void dtmf_wav_drift_update(struct dtmf_drift *drift, struct dtmf_level *lv,
+				  s16 *buf, int width, int rate, int j)
+{
+	for (int k = 0; k < DTMF_LEVELS; k++)
+		if (dtmf_fq[k] == lv->low ||
+		    dtmf_fq[k] == lv->hi)
+			dtmf_drift_update(drift + k, buf, width, rate, dtmf_fq[k], j);
+}
+
+static void dtmf_wav_drift(struct dev_param *param, struct dtmf_drift *drift, int width)
+{
+	for (int i = 0; i < param->chan; i++) {
+		double sum = 0;
+		double weight = 0;
+
+		printf("ch%-2d drift   :", i);
+		for (int k = 0; k < DTMF_LEVELS; k++) {
+			struct dtmf_drift *dr = drift + (DTMF_LEVELS * i) + k;
+			double ppm = dtmf_drift_ppm(dr, width, param->rate, dtmf_fq[k]);
+			double w   = dr->sxx * dtmf_fq[k] * dtmf_fq[k];
+
+			if (!dr->sxx)
+				continue;
+
+			printf(" %dHz %+.2f ppm,", dtmf_fq[k], ppm);
+
+			// phase slope accuracy is same on each tone
+			sum    += ppm * w;
+			weight += w;
+		}
+
+		if (!weight) {
+			printf(" -\n");
+			continue;
+		}
+
+		sum /= weight;
+		printf(" %+.2f ppm (rate %.3f)\n", sum, param->rate / (1 + sum / 1000000));
+	}
+}
+
+//=======================================
+//
+// dtmf_wav_challenge
+//
+// 1 challenge is DEGREE% of rate (= width).
+// length / width never overflow, because length is frames.
+//
+//	Total challenges = param->length / (param->rate / 100 * DEGREE)
+//
+//=======================================
+static int dtmf_wav_challenge(struct dev_param *param, int *width)
+{
+	*width = param->rate / 100 * DEGREE;
+
+	return param->length / *width;
+}
+
+//=======================================
+//
+// dtmf_wav_analyze_window
+// dtmf_wav_analyze_chan
+// dtmf_wav_analyze_stream
+//
+// analyze_window analyzes 1 challenge (j) of 1ch (i) on buf.
+//
+// analyze_chan   analyzes 1ch data on param->buf.
+// analyze_stream reads 1 challenge of all channels each, and analyzes it.
+// It doesn't keep all data, thus -d can handle long file.
+//
+//	                 <-- width --->
+//	param->buf    = [LRLRLRLR...LR]
+//	deinterleave  = [LLLL...][RRRR...]
+//
+//=======================================
+static void dtmf_wav_analyze_window(struct dev_param *param, int i, int j, s16 *buf,
+				    char *result, int challenge, int width,
+				    FILE *trace, struct dtmf_drift *drift,
+				    struct dtmf_memo *memo)
+{
+	struct dtmf_level lv;
+
+	if (memo)
+		result[challenge * i + j] = dtmf_memo_analyze(memo, buf, width,
+							      param->rate, &lv);
+	else
+		result[challenge * i + j] = dtmf_analyze_kernel(param->kernel, buf,
+								width, 1,
+								param->rate, &lv);
+	if (trace)
+		trace_print(trace, i, j, &lv, result[challenge * i + j]);
+	if (is_drift(param) && result[challenge * i + j] != unknown)
+		dtmf_wav_drift_update(drift + (DTMF_LEVELS * i), &lv,
+				      buf, width, param->rate, j);
+}
+
+static void dtmf_wav_analyze_chan(struct dev_param *param, int i, char *result,
+				  int challenge, int width,
+				  FILE *trace, struct dtmf_drift *drift,
+				  struct dtmf_memo *memo)
+{
+	long hit = 0;
+	int j;
+
+	if (memo)
+		hit = memo->hit;
+
+	// analyze par 1 width
+	prof_start(PROF_COMPUTE);
+	for (j = 0; j < challenge; j++)
+		dtmf_wav_analyze_window(param, i, j, param->buf + (width * j),
+					result, challenge, width, trace, drift, memo);
+	prof_stop(PROF_COMPUTE);
+
+	// memo hit was not analyzed
+	if (memo)
+		hit = memo->hit - hit;
+
+	prof_add(PROF_ANALYZED, challenge - hit);
+	prof_add(PROF_SKIPPED,  hit);
+	prof_add(PROF_SAMPLES,  (challenge - hit) * width);
+}
+
+static int dtmf_wav_analyze_stream(struct dev_param *param, char *result,
+				   int challenge, int width,
+				   FILE *trace, struct dtmf_drift *drift,
+				   struct dtmf_memo *memo)
+{
+	FILE *fp;
+	s16 *win = param->buf + (width * param->chan);
+	long hit = 0;
+	int ret;
+	int i, j, k;
+
+	ret = wav_open_data(param, &fp);
+	if (ret < 0)
+		return ret;
+
+	if (memo)
+		hit = memo->hit;
+
+	for (j = 0; j < challenge; j++) {
+		prof_start(PROF_READ);
+		ret = wav_read_frames(param, fp, param->buf, width);
+		prof_stop(PROF_READ);
+		if (ret < 0)
+			goto err;
+
+		prof_start(PROF_COMPUTE);
+		for (i = 0; i < param->chan; i++) {
+			for (k = 0; k < width; k++)
+				win[k] = param->buf[(param->chan * k) + i];
+
+			dtmf_wav_analyze_window(param, i, j, win, result, challenge,
+						width, trace, drift, memo);
+		}
+		prof_stop(PROF_COMPUTE);
+	}
+
+	// memo hit was not analyzed
+	if (memo)
+		hit = memo->hit - hit;
+
+	prof_add(PROF_ANALYZED, challenge * param->chan - hit);
+	prof_add(PROF_SKIPPED,  hit);
+	prof_add(PROF_SAMPLES,  (challenge * param->chan - hit) * width);
+err:
+	fclose(fp);
+
+	return ret;
+}
+
 //=======================================
 //
 // dtmf_wav_analyze
 //
 //=======================================
-#define DEGREE	10	// 10%
 static int dtmf_wav_analyze(struct dev_param *param)
 {
+	struct dtmf_drift drift[MAX_CHAN * DTMF_LEVELS];
+	FILE *trace = NULL;
+	struct dtmf_decoder dec;
+	struct dtmf_memo memo;
+	struct hash hash;
+	u64 key = 0;
+	s16 *buf = NULL;
+	int cache = is_cache(param);
 	int ret;
 	int challenge;
 	char *result;
-	char prev[MAX_CHAN];
+	char *out;
+	int size;
 	int i, j;
-	int comma = 0;
-	int late_j = 0;
 	int width;
 
 	//==========================
 	// read wav header, and fill params
 	//==========================
+	prof_start(PROF_HEADER);
 	ret = wav_read_header(param);
+	prof_stop(PROF_HEADER);
 	if (ret < 0)
 		goto err;
 
@@ -291,10 +810,42 @@ static int dtmf_wav_analyze(struct dev_param *param)
 		printf("bit     : %d\n", param->sample * 8);
 		printf("length  : %d\n", param->length);
 	}
+
+	// alloc for result
+	//
+	// wav_read_data() will read 1ch data each, and dtmf_analyze() will analyze specified data.
+	// We want to analyze 1ch data in 10% rate (= DEGREE) increments (= challenge),
+	// because it might include noise. Thus we need to keep the results.
+	//
+	// ex)
+	//	       <------ length ----- ... -->
+	//	       <- rate -><- rate -> ...
+	//	       <><><><><><><><><><>  (challenge)
+	//	buf = [xxxxxxxxxxxxxxxxxxxx ... xx]
+	//
+	// width = 1 challenge size
+	challenge = dtmf_wav_challenge(param, &width);
+
 	// alloc buf
-	ret = buf_alloc(param);
+	//
+	// -C needs all channels data to get the key before analyzing.
+	//
+	//	     <-- 1ch --><-- 2ch -->...
+	// buf    = [xxxxxxxxxxxyyyyyyyyyyy...]
+	//
+	// stream needs 1 challenge of all channels, and 1 deinterleaved challenge
+	//
+	//	     <-- width * chan --><-- width -->
+	// buf    = [LRLRLRLRLRLRLRLRLR][xxxxxxxxxxx]
+	if (is_stream(param)) {
+		param->length = width;
+		ret = buf_alloc(param, param->chan + 1);
+	} else {
+		ret = buf_alloc(param, cache ? param->chan : 1);
+	}
 	if (ret < 0)
 		goto err_buff;
+	buf = param->buf;
 
 	//==========================
 	// analyze DTMF
@@ -313,23 +864,6 @@ static int dtmf_wav_analyze(struct dev_param *param)
 	// }
 	//==========================
 
-	// alloc for result
-	//
-	// wav_read_data() will read 1ch data each, and dtmf_analyze() will analyze specified data.
-	// We want to analyze 1ch data in 10% rate (= DEGREE) increments (= challenge),
-	// because it might include noise. Thus we need to keep the results.
-	//
-	// ex)
-	//	       <------ length ----- ... -->
-	//	       <- rate -><- rate -> ...
-	//	       <><><><><><><><><><>  (challenge)
-	//	buf = [xxxxxxxxxxxxxxxxxxxx ... xx]
-	//
-	// 1 rate   has DEGREE% challenges (= param->rate / 100 * DEGREE)
-	// Total challenges = param->length / (param->rate / 100 * DEGREE)
-	//		    = param->length * 100 / param->rate / DEGREE
-	challenge = param->length * 100 / param->rate / DEGREE;
-
 	// 1ch needs "challenge" results, and we has param->chan.
 	//
 	// "result" will keep each channels result
@@ -337,144 +871,271 @@ static int dtmf_wav_analyze(struct dev_param *param)
 	//	     <-- 1ch --><-- 2ch -->...
 	// result = [xxxxxxxxxxxyyyyyyyyyyy...]
 	//
+	ret    = -ENOMEM;
 	result = calloc(param->chan, challenge);
 	if (!result)
 		goto err_buff;
 
-	// width = 1 challenge size
-	width = param->rate / 100 * DEGREE;
+	// decoded string.
+	// each challenge might be "," + chan
+	ret  = -ENOMEM;
+	size = (challenge + 1) * (param->chan + 1);
+	out  = calloc(1, size);
+	if (!out)
+		goto err_out;
 
-	// analyze for each channels.
-	for (i = 0; i < param->chan; i++) {
+	param->kernel = dtmf_kernel_select(param->rate, width);
+
+	memset(drift, 0, sizeof(drift));
+
+	// memo if -m
+	if (is_memo(param)) {
+		ret = dtmf_memo_init(&memo, param);
+		if (ret < 0)
+			goto free;
+	}
+
+	// trace file if -t
+	ret = -ENOENT;
+	if (param->trace && !(trace = trace_open(param)))
+		goto free;
+
+	if (cache)
+		hash_init(&hash, 0);
+
+	// analyze for each channels, or stream
+	if (is_stream(param)) {
+		ret = dtmf_wav_analyze_stream(param, result, challenge, width, trace, drift,
+					      is_memo(param) ? &memo : NULL);
+		if (ret < 0)
+			goto free;
+	}
+	for (i = 0; !is_stream(param) && i < param->chan; i++) {
 
 		// read each 1ch
+		if (cache)
+			param->buf = buf + (param->length * i);
+
+		prof_start(PROF_READ);
 		ret = wav_read_data(param, i);
+		prof_stop(PROF_READ);
 		if (ret < 0)
 			goto free;
 
-		// analyze par 1 width
-		for (j = 0; j < challenge; j++)
-			result[challenge * i + j] = dtmf_analyze(param->buf + (width * j),
-								 width,
-								 param->rate);
+		// -C analyzes it after cache check
+		if (cache) {
+			hash_update(&hash, param->buf, param->length * param->sample);
+			continue;
+		}
+
+		dtmf_wav_analyze_chan(param, i, result, challenge, width, trace, drift,
+				      is_memo(param) ? &memo : NULL);
 	}
 
-	if (is_versbose(param)) {
+	//==========================
+	// cache check
+	//
+	// key is based on data and analyze params.
+	// no need to analyze if hit
+	//==========================
+	if (cache) {
+		key = cache_key(&hash, param);
+		if (!cache_lookup(param, key, out, size)) {
+			prof_add(PROF_SKIPPED, challenge * param->chan);
+			printf("%s", out);
+			ret = 0;
+			goto free;
+		}
+
 		for (i = 0; i < param->chan; i++) {
-			for (j = 0; j < challenge; j++)
-				printf("%c", result[challenge * i + j]);
-			printf("\n");
+			param->buf = buf + (param->length * i);
+			dtmf_wav_analyze_chan(param, i, result, challenge, width, trace, drift,
+					      is_memo(param) ? &memo : NULL);
 		}
 	}
 
-	//
-	// In reality, data might have some dfmfs, and some parts might be noise
-	//
-	// <> : challenge
-	// vv : noise
-	//
-	//        vvvv               vvv          vvvv
-	// buf = [___xxxxxx____xxxxxxxx_____xxxxxxxx__]
-	//        <><><><><><><><><><><><><><><><><><>
-	//
-	// We keep prev "challenge" to judge either it was noise or not.
-	//
-	memset(&prev, 0, sizeof(prev));
+	if (is_versbose(param)) {
+		dtmf_result_print(result, challenge, param->chan);
+		if (is_memo(param))
+			printf("memo    : hit %ld, miss %ld\n", memo.hit, memo.miss);
+	}
 
+	//==========================
+	// decide
 	//
-	// handle each challenge and print it
-	//
-	// ex)
-	//
-	// result = [?? 11 11 22 22 ?? 33 33 3? ?9 ?? ?4 44 44 ?? 55 55 55 ??]
-	//
-	// print = 11 22 33 ?9 44 55
-	//
+	// dtmf_decoder handles noise and duplicated challenges
+	// see dtmf.c
+	//==========================
+	prof_start(PROF_DECIDE);
+	dtmf_decoder_init(&dec, param->chan, out, size);
 	for (j = 0; j < challenge; j++) {
-		int same = 0;
-		int uk = 0;
+		char col[MAX_CHAN];
 
-		// check prev challenge, unknown
-		for (i = 0; i < param->chan; i++) {
-			if (result[challenge * i + j] == prev[i])
-				same++;
-			if (result[challenge * i + j] == unknown)
-				uk++;
-		}
+		for (i = 0; i < param->chan; i++)
+			col[i] = result[challenge * i + j];
 
-		//    skip if all data were same as prev data. (.. 33 33 ..)
-		// or skip if all data were unknown (noise)    (.. ?? ..)
-		if (same == param->chan ||
-		    uk   == param->chan)
-			continue;
+		dtmf_decoder_push(&dec, col);
+	}
+	dtmf_decoder_finish(&dec);
 
-		// ex)
-		//
-		// result ~= [11 22 33 3? ?9 ?4 44 55]
-		//
-
-		// [.. 3? .. ?9 .. ?4 ..]
-		if (uk) {
-			//        *
-			// [.. 33 3? ..]
-			// it is noise
-			if (same > 0)
-				continue;
+	printf("%s", out);
+	prof_stop(PROF_DECIDE);
 
-			//      *
-			// [.. ?4 44 ..]
-			// it is also noise, but we can't judge it now.
-			// late judge
+	if (cache)
+		cache_store(param, key, out);
 
-			// finish if it was last challenge
-			if (j + 1 >= challenge)
-				continue;
+	// success
+	ret = 0;
+free:
+	printf("\n");
+	if (!ret && is_latency(param))
+		ret = dtmf_wav_latency(param, result, challenge, width);
+	if (!ret && is_xrun(param))
+		ret = dtmf_wav_xrun(param, result, challenge, width);
+	if (!ret && is_drift(param))
+		dtmf_wav_drift(param, drift, width);
+	if (trace)
+		fclose(trace);
+	if (is_memo(param))
+		dtmf_memo_exit(&memo);
+	free(out);
+err_out:
+	free(result);
+err_buff:
+	param->buf = buf;
+	buf_free(param);
+err:
+	return ret;
+}
 
-			late_j = 1;
-		}
+//=======================================
+//
+// dtmf_wav_expect
+//
+// -e check.
+// It reads and analyzes 1 challenge of all channels each,
+// and stops as soon as the result was decided.
+//
+//	expect = "12,34"
+//	out    = "12"		: continue (prefix of expect)
+//	out    = "12,34"	: continue (tone might be continued)
+//	out    = "12,34" + ??	: match, stop (EXPECT_TAIL silence after it)
+//	out    = "12,56"	: mismatch, stop
+//	out    = "12,34,12"	: mismatch, stop
+//
+// Otherwise, it is decided at the end of data.
+//
+// return 0 if match, 1 if mismatch
+//
+//=======================================
+#define EXPECT_TAIL	2	// 200ms
+static int dtmf_wav_expect(struct dev_param *param)
+{
+	struct dtmf_level lv;
+	struct dtmf_decoder dec;
+	FILE *fp = NULL;
+	char *out;
+	int len = strlen(param->expect);
+	int challenge;
+	int width;
+	int tail = 0;
+	int ret;
+	int i, j;
 
-		if (late_j) {
-			int noise = 0;
+	//==========================
+	// read wav header, and fill params
+	//==========================
+	prof_start(PROF_HEADER);
+	ret = wav_read_header(param);
+	prof_stop(PROF_HEADER);
+	if (ret < 0)
+		goto err;
 
-			//      *
-			// [.. ?4 44 ..]     noise
-			// [.. ?9 ?4 ..] not noise
-			for (i = 0; i < param->chan; i++)
-				if (result[challenge * i + j] != unknown &&
-				    (result[challenge * i + j] ==
-				     result[challenge * i + j + 1]))
-					noise++;
+	if (is_versbose(param)) {
+		printf("chan    : %d\n", param->chan);
+		printf("rate    : %d\n", param->rate);
+		printf("bit     : %d\n", param->sample * 8);
+		printf("length  : %d\n", param->length);
+	}
 
-			if (noise)
-				goto next;
-		}
+	challenge = dtmf_wav_challenge(param, &width);
+	param->kernel = dtmf_kernel_select(param->rate, width);
+
+	//==========================
+	// alloc buf for 1 challenge of all channels
+	//
+	//	       <-- width --->
+	//	buf = [LRLRLRLR...LR]
+	//==========================
+	param->length = width;
+	ret = buf_alloc(param, param->chan);
+	if (ret < 0)
+		goto err;
 
-		if (comma)
-			printf(",");
+	// out never be longer than expect + "," + 1 token before mismatch
+	ret  = -ENOMEM;
+	out  = calloc(1, len + param->chan + 2);
+	if (!out)
+		goto err_out;
 
-		// print current data
-		for (i = 0; i < param->chan; i++)
-			printf("%c", result[challenge * i + j]);
+	ret = wav_open_data(param, &fp);
+	if (ret < 0)
+		goto free;
 
-next:		// keep prev[]
+	dtmf_decoder_init(&dec, param->chan, out, len + param->chan + 2);
+	for (j = 0; j < challenge; j++) {
+		char col[MAX_CHAN];
+
+		prof_start(PROF_READ);
+		ret = wav_read_frames(param, fp, param->buf, width);
+		prof_stop(PROF_READ);
+		if (ret < 0)
+			goto close;
+
+		prof_start(PROF_COMPUTE);
 		for (i = 0; i < param->chan; i++)
-			prev[i] = result[challenge * i + j];
+			col[i] = dtmf_analyze_kernel(param->kernel, param->buf + i, width,
+						     param->chan, param->rate, &lv);
+		prof_stop(PROF_COMPUTE);
+		prof_add(PROF_ANALYZED, param->chan);
+		prof_add(PROF_SAMPLES,  param->chan * width);
+
+		prof_start(PROF_DECIDE);
+		dtmf_decoder_push(&dec, col);
+		prof_stop(PROF_DECIDE);
+
+		// mismatch
+		if (strncmp(out, param->expect, dec.len) ||
+		    dec.len > len)
+			break;
 
-		comma  = 1;
-		late_j = 0;
+		// match, and tone was finished
+		for (i = 0; i < param->chan; i++)
+			if (col[i] != unknown)
+				break;
+		tail = (dec.len == len && i == param->chan) ? tail + 1 : 0;
+		if (tail == EXPECT_TAIL) {
+			dtmf_decoder_finish(&dec);
+			break;
+		}
 	}
 
-	// all "?" case
-	if (!comma)
-		for (i = 0; i < param->chan; i++)
-			printf("%c", unknown);
+	// it was last challenge
+	if (j == challenge)
+		dtmf_decoder_finish(&dec);
 
-	// success
-	ret = 0;
+	ret = !!strcmp(out, param->expect);
+
+	printf("%s\n", out);
+	if (is_versbose(param))
+		printf("expect  : %s - %s (%d/%d challenge)\n",
+		       param->expect, ret ? "NG" : "OK",
+		       (j == challenge) ? j : j + 1, challenge);
+close:
+	fclose(fp);
 free:
-	printf("\n");
-	free(result);
-err_buff:
+	free(out);
+err_out:
 	buf_free(param);
 err:
 	return ret;
@@ -528,19 +1189,49 @@ int main(int argc, char **argv)
 	//==========================
 	switch (param.flag & FLAG_TYPE_MASK) {
 	case FLAG_TYPE_OUT:
-		ret = dtmf_wav_write(&param);
+		if (param.flag & FLAG_MATRIX)
+			ret = dtmf_matrix_write(&param);
+		else
+			ret = dtmf_wav_write(&param);
 		break;
 	case FLAG_TYPE_IN:
-		ret = dtmf_wav_analyze(&param);
+		if (param.flag & FLAG_MATRIX)
+			ret = dtmf_matrix_analyze(&param);
+		else if (dtmf_pack_check(&param))
+			ret = is_wav_only(&param) ? -EINVAL : dtmf_pack_analyze(&param);
+		else if (dtmf_flac_check(&param))
+			ret = is_wav_only(&param) ? -EINVAL : dtmf_flac_analyze(&param);
+		else if (param.scan)
+			ret = dtmf_scan_analyze(&param);
+		else if (param.expect)
+			ret = dtmf_wav_expect(&param);
+		else
+			ret = dtmf_wav_analyze(&param);
 		break;
 	case FLAG_TYPE_INFO:
 		ret = dtmf_wav_info(&param);
 		break;
+	case FLAG_TYPE_SIM:
+		ret = dtmf_sim(&param);
+		break;
+	case FLAG_TYPE_SHM:
+		ret = dtmf_shm_analyze(&param);
+		break;
+	case FLAG_TYPE_PACK:
+		ret = dtmf_pack_write(&param);
+		break;
+	case FLAG_TYPE_BENCH:
+		ret = dtmf_bench(&param);
+		break;
+	case FLAG_TYPE_BATCH:
+		ret = dtmf_batch(&param);
+		break;
 	default:
 		ret = -EINVAL;
 		break;
 	}
 
+	prof_report();
 err:
 	if (ret < 0)
 		printf("%s\n", strerror(ret * -1));
@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: GPLv2
+//
+// matrix.c
+//
+// Copyright (c) 2026 agent <agent@local>
+//
+#include "param.h"
+
+//=================================================
+//
+//
+//		defines
+//
+//
+//=================================================
+//
+// routing matrix check
+//
+// Each output channel has unique tone pair (= signature) in its own
+// time slot. Thus all output channels can be checked by 1 capture,
+// even though some of them are mixed into same input channel.
+//
+//	signature = low[chan / 4] + hi[chan % 4]
+//
+//	         <-slot-><-slot-><-slot->
+//	out 0 = [xxxxxx_ ________ ________ ...]
+//	out 1 = [_______ xxxxxx__ ________ ...]
+//	out 2 = [_______ ________ xxxxxx__ ...]
+//
+// tone is longer than 2 windows (= challenge), thus there is at least
+// 1 window which is fully in the tone regardless of the latency.
+//
+#define MATRIX_SLOT(rate)	((rate) * 3 / 10)	// 300ms
+#define MATRIX_TONE(rate)	((rate) / 4)		// 250ms
+
+static char matrix_file[] = "matrix.wav";
+
+#define matrix_low(chan)	dtmf_fq[(chan) / 4]
+#define matrix_hi(chan)		dtmf_fq[(chan) % 4 + 4]
+
+//=======================================
+//
+// dtmf_matrix_write
+//
+//=======================================
+int dtmf_matrix_write(struct dev_param *param)
+{
+	int slot = MATRIX_SLOT(param->rate);
+	int tone = MATRIX_TONE(param->rate);
+	int ret = -ENOMEM;
+
+	param->length	= slot * param->chan;
+	param->filename	= matrix_file;
+
+	param->buf = calloc(param->length, param->sample);
+	if (!param->buf)
+		goto err;
+
+	if (param->flag & FLAG_VERBOSE) {
+		printf("chan    : %d\n", param->chan);
+		printf("rate    : %d\n", param->rate);
+		printf("bit     : %d\n", param->sample * 8);
+		printf("length  : %d\n", param->length);
+	}
+
+	printf("%s\n", param->filename);
+
+	ret = wav_write_header(param);
+	if (ret < 0)
+		goto free;
+
+	for (int chan = 0; chan < param->chan; chan++) {
+		memset(param->buf, 0, param->length * param->sample);
+
+		ret = dtmf_fill_tone(param->buf + slot * chan, tone,
+				     param->rate, param->sample,
+				     matrix_low(chan), matrix_hi(chan));
+		if (ret < 0)
+			goto free;
+
+		ret = wav_write_data(param, chan);
+		if (ret < 0)
+			goto free;
+	}
+
+	// success
+	ret = 0;
+free:
+	free(param->buf);
+	param->buf = NULL;
+err:
+	return ret;
+}
+
+//=======================================
+//
+// matrix_level
+//
+// sum of the signature tone pair level
+//
+//=======================================
+static double matrix_level(struct dtmf_level *lv, int chan)
+{
+	double level = 0;
+
+	for (int i = 0; i < DTMF_LEVELS; i++)
+		if (dtmf_fq[i] == matrix_low(chan) ||
+		    dtmf_fq[i] == matrix_hi(chan))
+			level += lv->level[i];
+
+	return level;
+}
+
+//=======================================
+//
+// dtmf_matrix_analyze
+//
+// It indicates input (= row) vs output (= column) gain in dB.
+// "-" means there is no route.
+//
+//	       o0     o1     o2     o3
+//	i0     +0.0      -      -   -6.0
+//	i1        -   +0.0      -   -6.0
+//
+//=======================================
+int dtmf_matrix_analyze(struct dev_param *param)
+{
+	struct dtmf_level lv;
+	double ref[MAX_CHAN];
+	double *gain;
+	int width;
+	int challenge;
+	int outs = 0;
+	int ret;
+	int i, j, o;
+
+	ret = wav_read_header(param);
+	if (ret < 0)
+		goto err;
+
+	ret = -ENOMEM;
+	width		= param->rate / 100 * DEGREE;
+	challenge	= param->length / width;
+
+	// gain[input * MAX_CHAN + output]
+	gain = calloc(param->chan * MAX_CHAN, sizeof(double));
+	if (!gain)
+		goto err;
+
+	param->buf = calloc(param->length > width ? param->length : width, param->sample);
+	if (!param->buf)
+		goto free;
+
+	//==========================
+	// reference level
+	//
+	// level of the generated signature itself
+	//==========================
+	for (o = 0; o < MAX_CHAN; o++) {
+		dtmf_fill_tone(param->buf, width, param->rate, param->sample,
+			       matrix_low(o), matrix_hi(o));
+		dtmf_analyze_level(param->buf, width, param->rate, &lv);
+		ref[o] = matrix_level(&lv, o);
+	}
+
+	//==========================
+	// find signature on each input channels
+	//
+	// it keeps max level, because some windows are
+	// not fully in the tone
+	//==========================
+	for (i = 0; i < param->chan; i++) {
+		ret = wav_read_data(param, i);
+		if (ret < 0)
+			goto free;
+
+		for (j = 0; j < challenge; j++) {
+			double level;
+
+			dtmf_analyze_level(param->buf + width * j, width, param->rate, &lv);
+			if (lv.low < 0 || lv.hi < 0)
+				continue;
+
+			for (o = 0; o < MAX_CHAN; o++)
+				if (lv.low == matrix_low(o) &&
+				    lv.hi  == matrix_hi(o))
+					break;
+
+			level = matrix_level(&lv, o);
+			if (gain[i * MAX_CHAN + o] < level)
+				gain[i * MAX_CHAN + o] = level;
+
+			if (outs < o + 1)
+				outs = o + 1;
+		}
+	}
+
+	//==========================
+	// print matrix
+	//==========================
+	printf("    ");
+	for (o = 0; o < outs; o++)
+		printf("    o%-2d", o);
+	printf("\n");
+
+	for (i = 0; i < param->chan; i++) {
+		printf("i%-2d ", i);
+		for (o = 0; o < outs; o++) {
+			double level = gain[i * MAX_CHAN + o];
+
+			if (level > 0)
+				printf(" %+6.1f", 20 * log10(level / ref[o]));
+			else
+				printf("      -");
+		}
+		printf("\n");
+	}
+
+	// success
+	ret = 0;
+free:
+	free(param->buf);
+	param->buf = NULL;
+	free(gain);
+err:
+	return ret;
+}
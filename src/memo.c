@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: GPLv2
+//
+// memo.c
+//
+// Copyright (c) 2026 agent <agent@local>
+//
+#include "param.h"
+
+//=================================================
+//
+//
+//		defines
+//
+//
+//=================================================
+//
+// memo of analyzed challenge
+//
+// Digital loopback / generated data has many same challenges
+// (ex. digital silence, or tone which period fits to width).
+// Keep dtmf_analyze_level() result of each challenge by its hash,
+// and use it again if same data came.
+//
+//	key   = hash64(challenge data, rate)
+//	table = [entry][entry]...[entry]	(direct mapped, key % size)
+//
+// The entry is just overwritten if other key used same index,
+// thus memory size is fixed.
+//
+#define MEMO_SIZE	1024
+#define MEMO_MAX	(1 << 20)
+
+struct memo_entry {
+	u64 key;
+	int length;
+	int valid;
+	struct dtmf_level lv;
+	char num;
+};
+
+//=======================================
+//
+// dtmf_memo_init
+// dtmf_memo_exit
+//
+// size is rounded up to power of 2
+//
+//=======================================
+int dtmf_memo_init(struct dtmf_memo *memo, struct dev_param *param)
+{
+	int size = (param->memo) ? atoi(param->memo) : MEMO_SIZE;
+	int mask;
+
+	memset(memo, 0, sizeof(*memo));
+
+	if (size <= 0 || size > MEMO_MAX)
+		return -EINVAL;
+
+	for (mask = 1; mask < size; mask <<= 1)
+		;
+
+	memo->table = calloc(mask, sizeof(struct memo_entry));
+	if (!memo->table)
+		return -ENOMEM;
+
+	memo->mask   = mask - 1;
+	memo->kernel = param->kernel;
+
+	return 0;
+}
+
+void dtmf_memo_exit(struct dtmf_memo *memo)
+{
+	free(memo->table);
+	memo->table = NULL;
+}
+
+//=======================================
+//
+// dtmf_memo_analyze
+//
+// same as dtmf_analyze_level(), but it uses memo if possible.
+// lv is also same as analyzed one, thus -t, -d can use it.
+//
+//=======================================
+char dtmf_memo_analyze(struct dtmf_memo *memo, s16 *buf, int length, int rate,
+		       struct dtmf_level *lv)
+{
+	struct memo_entry *entry;
+	u64 key = hash64(buf, length * sizeof(s16), rate);
+
+	entry = (struct memo_entry *)memo->table + (key & memo->mask);
+	if (entry->valid &&
+	    entry->key    == key &&
+	    entry->length == length) {
+		memo->hit++;
+		*lv = entry->lv;
+		return entry->num;
+	}
+
+	memo->miss++;
+
+	entry->num	= dtmf_analyze_kernel(memo->kernel, buf, length, 1, rate, &entry->lv);
+	entry->key	= key;
+	entry->length	= length;
+	entry->valid	= 1;
+
+	*lv = entry->lv;
+
+	return entry->num;
+}
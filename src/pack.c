@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: GPLv2
+//
+// pack.c
+//
+// Copyright (c) 2026 agent <agent@local>
+//
+#include <fcntl.h>
+#include <libgen.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "param.h"
+#include "pack.h"
+
+//=================================================
+//
+//
+//		defines
+//
+//
+//=================================================
+#define pack_align(x)	(((x) + PACK_ALIGN - 1) & ~(u64)(PACK_ALIGN - 1))
+
+//=======================================
+//
+// dtmf_pack_write
+//
+// ex) simple_dtmf -p corpus.pack *.wav
+//
+//=======================================
+int dtmf_pack_write(struct dev_param *param)
+{
+	struct pack_entry *entry;
+	struct pack pack;
+	char *pack_file = param->filename;
+	FILE *in = NULL;
+	FILE *fp;
+	u64 offset;
+	int ret = -ENOMEM;
+	int i;
+
+	entry = calloc(param->files_nr, sizeof(*entry));
+	if (!entry)
+		goto err;
+
+	//==========================
+	// create index
+	//==========================
+	offset = pack_align(sizeof(pack) + sizeof(*entry) * param->files_nr);
+	for (i = 0; i < param->files_nr; i++) {
+		param->filename = param->files[i];
+
+		ret = wav_read_header(param);
+		if (ret < 0)
+			goto free;
+
+		snprintf(entry[i].name, PACK_NAME, "%s", basename(param->files[i]));
+		entry[i].rate	= param->rate;
+		entry[i].chan	= param->chan;
+		entry[i].sample	= param->sample;
+		entry[i].length	= param->length;
+		entry[i].offset	= offset;
+
+		offset = pack_align(offset + (u64)param->length * param->chan * param->sample);
+	}
+
+	memcpy(pack.magic, PACK_MAGIC, sizeof(pack.magic));
+	pack.version	= PACK_VERSION;
+	pack.entries	= param->files_nr;
+	pack.reserved	= 0;
+
+	//==========================
+	// write header and index
+	//==========================
+	ret = -ENOENT;
+	fp = fopen(pack_file, "w");
+	if (!fp)
+		goto free;
+
+	ret = -EIO;
+	if (!fwrite(&pack, sizeof(pack), 1, fp) ||
+	    fwrite(entry, sizeof(*entry), param->files_nr, fp) != param->files_nr)
+		goto close;
+
+	//==========================
+	// copy data
+	//==========================
+	for (i = 0; i < param->files_nr; i++) {
+		param->filename	= param->files[i];
+		param->rate	= entry[i].rate;
+		param->chan	= entry[i].chan;
+		param->sample	= entry[i].sample;
+		param->length	= entry[i].length;
+
+		ret = -ENOMEM;
+		param->buf = calloc((size_t)param->length * param->chan, param->sample);
+		if (!param->buf)
+			goto close;
+
+		ret = wav_open_data(param, &in);
+		if (ret < 0)
+			goto close;
+
+		ret = wav_read_frames(param, in, param->buf, param->length);
+		fclose(in);
+		if (ret < 0)
+			goto close;
+
+		ret = -EIO;
+		if (fseeko(fp, entry[i].offset, SEEK_SET) ||
+		    fwrite(param->buf, param->sample * param->chan,
+			   param->length, fp) != param->length)
+			goto close;
+
+		free(param->buf);
+		param->buf = NULL;
+
+		if (param->flag & FLAG_VERBOSE)
+			printf("%s : %d Hz, %d ch, %d frames\n",
+			       entry[i].name, entry[i].rate, entry[i].chan, entry[i].length);
+	}
+
+	// success
+	ret = 0;
+close:
+	if (fclose(fp) && !ret)
+		ret = -EIO;
+	free(param->buf);
+	param->buf = NULL;
+free:
+	free(entry);
+	param->filename = pack_file;
+err:
+	return ret;
+}
+
+//=======================================
+//
+// dtmf_pack_check
+//
+// return 1 if it was pack file
+//
+//=======================================
+int dtmf_pack_check(struct dev_param *param)
+{
+	char magic[4];
+	FILE *fp;
+	int ret = 0;
+
+	fp = fopen(param->filename, "r");
+	if (!fp)
+		return 0;
+
+	if (fread(magic, sizeof(magic), 1, fp) &&
+	    !memcmp(magic, PACK_MAGIC, sizeof(magic)))
+		ret = 1;
+
+	fclose(fp);
+
+	return ret;
+}
+
+//=======================================
+//
+// dtmf_pack_analyze_entry
+//
+// same as dtmf_wav_analyze() without wav file access.
+// interleaved data is analyzed directly.
+//
+//=======================================
+static void dtmf_pack_analyze_entry(struct dev_param *param, struct pack_entry *entry,
+				    s16 *data, char *result, char *out, int size)
+{
+	int chan = entry->chan;
+	int challenge;
+
+	prof_start(PROF_COMPUTE);
+	challenge = dtmf_analyze_frames(dtmf_kernel_select(entry->rate, entry->rate / 100 * DEGREE),
+					data, entry->length, entry->rate, chan, result);
+	prof_stop(PROF_COMPUTE);
+	prof_add(PROF_ANALYZED, challenge * chan);
+	prof_add(PROF_SAMPLES,  challenge * chan * (entry->rate / 100 * DEGREE));
+
+	if (param->flag & FLAG_VERBOSE) {
+		printf("%.*s : %d Hz, %d ch, %d frames\n", PACK_NAME,
+		       entry->name, entry->rate, entry->chan, entry->length);
+		dtmf_result_print(result, challenge, chan);
+	}
+
+	prof_start(PROF_DECIDE);
+	dtmf_decode_result(result, challenge, chan, out, size);
+	prof_stop(PROF_DECIDE);
+
+	printf("%.*s %s\n", PACK_NAME, entry->name, out);
+}
+
+//=======================================
+//
+// dtmf_pack_analyze
+//
+// print "name result" for each entries
+//
+//=======================================
+int dtmf_pack_analyze(struct dev_param *param)
+{
+	struct pack_entry *entry;
+	struct pack *pack;
+	struct stat st;
+	char *result = NULL;
+	char *out = NULL;
+	char *top;
+	u64 index;
+	int max = 0;
+	int size = 0;
+	int fd;
+	int i;
+	int ret = -ENOENT;
+
+	//==========================
+	// map whole file
+	//==========================
+	prof_start(PROF_HEADER);
+	fd = open(param->filename, O_RDONLY);
+	if (fd < 0)
+		goto err;
+
+	ret = -EINVAL;
+	if (fstat(fd, &st) < 0 ||
+	    st.st_size < sizeof(*pack))
+		goto close;
+
+	top = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (top == MAP_FAILED)
+		goto close;
+	prof_add(PROF_CALLS, 3);
+
+	madvise(top, st.st_size, MADV_SEQUENTIAL);
+
+	//==========================
+	// check header and index
+	//==========================
+	pack  = (struct pack *)top;
+	entry = (struct pack_entry *)(pack + 1);
+	index = sizeof(*pack) + (u64)pack->entries * sizeof(*entry);
+
+	if (memcmp(pack->magic, PACK_MAGIC, sizeof(pack->magic)) ||
+	    pack->version != PACK_VERSION ||
+	    index > st.st_size)
+		goto unmap;
+
+	for (i = 0; i < pack->entries; i++) {
+		struct pack_entry *e = entry + i;
+		int width = e->rate / 100 * DEGREE;
+
+		if (e->chan   == 0		||
+		    e->chan   >  MAX_CHAN	||
+		    e->sample != sizeof(s16)	||
+		    width     <= 0		||
+		    e->offset %  PACK_ALIGN	||
+		    e->offset <  index		||
+		    e->offset + (u64)e->length * e->chan * e->sample > st.st_size)
+			goto unmap;
+
+		// result/out size for biggest entry
+		if (max < (e->length / width) * e->chan)
+			max = (e->length / width) * e->chan;
+		if (size < (e->length / width + 1) * (e->chan + 1))
+			size = (e->length / width + 1) * (e->chan + 1);
+	}
+	prof_stop(PROF_HEADER);
+
+	ret = -ENOMEM;
+	result	= calloc(1, max + 1);
+	out	= calloc(1, size + 1);
+	if (!result || !out)
+		goto unmap;
+
+	//==========================
+	// analyze each entries
+	//==========================
+	for (i = 0; i < pack->entries; i++) {
+		prof_add(PROF_BYTES, (u64)entry[i].length * entry[i].chan * entry[i].sample);
+		dtmf_pack_analyze_entry(param, entry + i, (s16 *)(top + entry[i].offset),
+					result, out, size + 1);
+	}
+
+	// success
+	ret = 0;
+unmap:
+	free(result);
+	free(out);
+	munmap(top, st.st_size);
+close:
+	close(fd);
+err:
+	return ret;
+}
@@ -0,0 +1,53 @@
+/* SPDX-License-Identifier: GPLv2
+ *
+ * pack.h
+ *
+ * Copyright (c) 2026 agent <agent@local>
+ */
+#ifndef __PACK_H
+#define __PACK_H
+
+#include <stdint.h>
+
+/*
+ * corpus pack file for -p / -i
+ *
+ * many wav data in 1 file, to avoid per file open/header parse.
+ *
+ *	+------------------+ 0
+ *	| struct pack      |
+ *	| struct pack_entry| index
+ *	| ...              |
+ *	+------------------+ PACK_ALIGN
+ *	| entry 0 data     |  [ch0][ch1]...[chN] (S16_LE, interleaved)
+ *	+------------------+ PACK_ALIGN
+ *	| entry 1 data     |
+ *	| ...              |
+ *	+------------------+
+ *
+ * each entry data is page aligned, thus it can be mmap()ed and
+ * analyzed directly.
+ */
+#define PACK_MAGIC	"DTPK"
+#define PACK_VERSION	1
+#define PACK_ALIGN	4096
+#define PACK_NAME	40
+
+struct pack {
+	char	 magic[4];
+	uint32_t version;
+	uint32_t entries;
+	uint32_t reserved;
+};
+
+struct pack_entry {
+	char	 name[PACK_NAME];	/* basename of wav file */
+	uint32_t rate;
+	uint16_t chan;
+	uint16_t sample;		/* bytes, 2 only for now */
+	uint32_t length;		/* frames */
+	uint32_t reserved;
+	uint64_t offset;		/* from top of file, PACK_ALIGN */
+};
+
+#endif /* __PACK_H */
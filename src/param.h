@@ -16,8 +16,19 @@
 #define FLAG_TYPE_OUT	(0x1 << 0)
 #define FLAG_TYPE_IN	(0x2 << 0)
 #define FLAG_TYPE_INFO	(0x3 << 0)
+#define FLAG_TYPE_SIM	(0x4 << 0)
+#define FLAG_TYPE_SHM	(0x5 << 0)
+#define FLAG_TYPE_PACK	(0x6 << 0)
+#define FLAG_TYPE_BENCH	(0x7 << 0)
+#define FLAG_TYPE_BATCH	(0x8 << 0)
 
 #define FLAG_VERBOSE	(1 << 31)
+#define FLAG_PROFILE	(1 << 30)
+#define FLAG_LATENCY	(1 << 29)
+#define FLAG_XRUN	(1 << 28)
+#define FLAG_DRIFT	(1 << 27)
+#define FLAG_MATRIX	(1 << 26)
+#define FLAG_MEMO	(1 << 25)
 
 struct dev_param {
 	/*
@@ -38,15 +49,141 @@ struct dev_param {
 	s16 *buf;
 	char *nums;
 	char *filename;
+	char *trace;	/* -t */
+	char *sim;	/* -S */
+	char *scan;	/* -f */
+	char *cache;	/* -C */
+	char *expect;	/* -e */
+	char *bench;	/* -B */
+	char *batch;	/* -a */
+	char *memo;	/* -m */
+	dtmf_kernel kernel;
+	char **files;	/* -p, -a */
+	int files_nr;
 };
 
 char dtmf_analyze(s16 *buf, int length, int rate);
+double dtmf_goertzel(s16 *buf, int length, int rate, int fq);
+char dtmf_analyze_level(s16 *buf, int length, int rate, struct dtmf_level *lv);
+char dtmf_analyze_data(struct dtmf_data *data, int rate, struct dtmf_level *lv);
+char dtmf_analyze_kernel(dtmf_kernel kernel, s16 *buf, int length, int stride,
+			 int rate, struct dtmf_level *lv);
+dtmf_kernel dtmf_kernel_select(int rate, int width);
 int dtmf_fill(s16 *buf, int length, int rate, int sample, char num);
+int dtmf_fill_tone(s16 *buf, int length, int rate, int sample, int tone_low, int tone_hi);
+double dtmf_onset(s16 *buf, int length, int rate, char num, int from, int to, int win);
+int dtmf_xrun(s16 *buf, int length, int rate, char num, int from, int to,
+	      struct dtmf_xrun *xrun, int max);
+void dtmf_drift_update(struct dtmf_drift *dr, s16 *buf, int length, int rate,
+		       int fq, int window);
+void dtmf_drift_flush(struct dtmf_drift *dr);
+double dtmf_drift_ppm(struct dtmf_drift *dr, int length, int rate, int fq);
+
+void dtmf_stream_init(struct dtmf_stream *st, int rate, int width);
+int  dtmf_stream_feed(struct dtmf_stream *st, const s16 *buf, int length, int stride, char *num);
+
+void dtmf_decoder_init(struct dtmf_decoder *dec, int chan, char *out, int size);
+void dtmf_decoder_push(struct dtmf_decoder *dec, const char *col);
+void dtmf_decoder_finish(struct dtmf_decoder *dec);
+
+int  dtmf_analyze_frames(dtmf_kernel kernel, s16 *data, int length, int rate,
+			 int chan, char *result);
+void dtmf_decode_result(const char *result, int challenge, int chan, char *out, int size);
+void dtmf_result_print(const char *result, int challenge, int chan);
+
+//
+// dtmf_memo_xxx() context
+//
+struct dtmf_memo {
+	dtmf_kernel kernel;
+	void *table;
+	u64 mask;
+	long hit;
+	long miss;
+};
+
+int  dtmf_memo_init(struct dtmf_memo *memo, struct dev_param *param);
+void dtmf_memo_exit(struct dtmf_memo *memo);
+char dtmf_memo_analyze(struct dtmf_memo *memo, s16 *buf, int length, int rate,
+		       struct dtmf_level *lv);
+
+int dtmf_sim(struct dev_param *param);
+unsigned int sim_rand(unsigned int *state);
+double sim_gauss(unsigned int *state);
+
+int dtmf_bench(struct dev_param *param);
+
+int dtmf_batch(struct dev_param *param);
+
+int dtmf_flac_check(struct dev_param *param);
+int dtmf_flac_analyze(struct dev_param *param);
+
+int dtmf_matrix_write(struct dev_param *param);
+int dtmf_matrix_analyze(struct dev_param *param);
+
+int dtmf_scan(s16 *buf, int length, int rate, const int *fq, int nr, double *level);
+int dtmf_scan_analyze(struct dev_param *param);
+
+int dtmf_shm_analyze(struct dev_param *param);
+
+int dtmf_pack_write(struct dev_param *param);
+int dtmf_pack_check(struct dev_param *param);
+int dtmf_pack_analyze(struct dev_param *param);
+
+u64  cache_key(struct hash *h, struct dev_param *param);
+int  cache_lookup(struct dev_param *param, u64 key, char *out, int size);
+void cache_store(struct dev_param *param, u64 key, const char *out);
 
 int wav_write_header(struct dev_param *param);
 int wav_write_data(struct dev_param *param, int chan);
 
+#define WAV_HEADER	44	// canonical header size
+int wav_parse_header(struct dev_param *param, const void *buf, int len);
 int wav_read_header(struct dev_param *param);
 int wav_read_data(struct dev_param *param, int chan);
+int wav_open_data(struct dev_param *param, FILE **fp);
+int wav_read_frames(struct dev_param *param, FILE *fp, s16 *buf, int frames);
+
+//=======================================
+//
+// profile
+//
+// prof_xxx() are no-op unless -P was indicated
+//
+//=======================================
+enum prof_stage {
+	PROF_HEADER,
+	PROF_READ,
+	PROF_COMPUTE,
+	PROF_DECIDE,
+	PROF_STAGE_MAX,
+};
+
+enum prof_count {
+	PROF_BYTES,
+	PROF_CALLS,
+	PROF_ANALYZED,
+	PROF_SKIPPED,
+	PROF_SAMPLES,
+	PROF_COUNT_MAX,
+};
+
+#define PROF_OFF	0
+#define PROF_TEXT	1
+#define PROF_JSON	2
+
+extern int prof_mode;
+
+void __prof_start(int stage);
+void __prof_stop(int stage);
+void __prof_add(int count, long num);
+void __prof_add_time(int stage, double sec);
+double prof_now(void);
+void prof_report(void);
+
+#define prof_start(stage)	do { if (prof_mode) __prof_start(stage);    } while (0)
+#define prof_stop(stage)	do { if (prof_mode) __prof_stop(stage);     } while (0)
+#define prof_add(count, num)	do { if (prof_mode) __prof_add(count, num); } while (0)
+#define prof_add_time(stage, sec) do { if (prof_mode) __prof_add_time(stage, sec); } while (0)
 
 #endif /* __PARAM_H */
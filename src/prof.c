@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: GPLv2
+//
+// prof.c
+//
+// Copyright (c) 2026 agent <agent@local>
+//
+#include <time.h>
+#include <sys/resource.h>
+#include "param.h"
+
+//=================================================
+//
+//
+//		defines
+//
+//
+//=================================================
+static const char *prof_stage_name[PROF_STAGE_MAX] = {
+	[PROF_HEADER]	= "header",
+	[PROF_READ]	= "read",
+	[PROF_COMPUTE]	= "compute",
+	[PROF_DECIDE]	= "decide",
+};
+
+static const char *prof_count_name[PROF_COUNT_MAX] = {
+	[PROF_BYTES]	= "bytes",
+	[PROF_CALLS]	= "io_calls",
+	[PROF_ANALYZED]	= "windows_analyzed",
+	[PROF_SKIPPED]	= "windows_skipped",
+	[PROF_SAMPLES]	= "samples",
+};
+
+int prof_mode = PROF_OFF;
+
+static double prof_time[PROF_STAGE_MAX];	// total sec
+static double prof_last[PROF_STAGE_MAX];	// prof_start() time
+static long   prof_count[PROF_COUNT_MAX];
+
+//=======================================
+//
+// prof_now
+//
+// worker threads can't use prof_start/stop(), because these are
+// not thread safe. They use prof_now() and merge it by
+// prof_add_time() after join.
+//
+//=======================================
+double prof_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+}
+
+//=======================================
+//
+// __prof_start
+// __prof_stop
+// __prof_add
+//
+//=======================================
+void __prof_start(int stage)
+{
+	prof_last[stage] = prof_now();
+}
+
+void __prof_stop(int stage)
+{
+	prof_time[stage] += prof_now() - prof_last[stage];
+}
+
+void __prof_add(int count, long num)
+{
+	prof_count[count] += num;
+}
+
+void __prof_add_time(int stage, double sec)
+{
+	prof_time[stage] += sec;
+}
+
+//=======================================
+//
+// prof_report
+//
+//=======================================
+void prof_report(void)
+{
+	struct rusage usage;
+	double total = 0;
+	double rate  = 0;
+	int i;
+
+	if (prof_mode == PROF_OFF)
+		return;
+
+	for (i = 0; i < PROF_STAGE_MAX; i++)
+		total += prof_time[i];
+
+	// samples/sec is based on Goertzel compute time
+	if (prof_time[PROF_COMPUTE] > 0)
+		rate = prof_count[PROF_SAMPLES] / prof_time[PROF_COMPUTE];
+
+	// ru_maxrss is KB on Linux
+	getrusage(RUSAGE_SELF, &usage);
+
+	if (prof_mode == PROF_JSON) {
+		fprintf(stderr, "{");
+		for (i = 0; i < PROF_STAGE_MAX; i++)
+			fprintf(stderr, "\"%s_sec\":%.9f,", prof_stage_name[i], prof_time[i]);
+		for (i = 0; i < PROF_COUNT_MAX; i++)
+			fprintf(stderr, "\"%s\":%ld,", prof_count_name[i], prof_count[i]);
+		fprintf(stderr, "\"total_sec\":%.9f,", total);
+		fprintf(stderr, "\"samples_per_sec\":%.0f,", rate);
+		fprintf(stderr, "\"peak_kb\":%ld}\n", usage.ru_maxrss);
+		return;
+	}
+
+	for (i = 0; i < PROF_STAGE_MAX; i++)
+		fprintf(stderr, "%-16s : %.6f sec\n", prof_stage_name[i], prof_time[i]);
+	for (i = 0; i < PROF_COUNT_MAX; i++)
+		fprintf(stderr, "%-16s : %ld\n", prof_count_name[i], prof_count[i]);
+	fprintf(stderr, "%-16s : %.6f sec\n", "total",		total);
+	fprintf(stderr, "%-16s : %.0f\n",     "samples/sec",	rate);
+	fprintf(stderr, "%-16s : %ld KB\n",   "peak memory",	usage.ru_maxrss);
+}
@@ -0,0 +1,475 @@
+// SPDX-License-Identifier: GPLv2
+//
+// scan.c
+//
+// Copyright (c) 2026 agent <agent@local>
+//
+#include "param.h"
+
+//=================================================
+//
+//
+//		defines
+//
+//
+//=================================================
+//
+// frequency scan
+//
+// Goertzel needs 1 pass for each frequency, FFT needs 1 pass for all.
+// It uses FFT if the number of frequency is over crossover point.
+// The crossover point is measured on 1st data when the plan was created.
+//
+// Goertzel is exact DFT on any frequency, but FFT is on each bin only.
+// FFT side uses Gaussian gridding (= NUFFT type 2, Greengard-Lee) to get
+// exact DFT on each frequency. Thus both are same level.
+//
+//	x[n]                        : n = [0, length)
+//	y[k] = x[k + c] / g^(k)     : deconvolve (c = length / 2)
+//	Y    = FFT(y)               : size = 2^n >= length * 2
+//	X(w) = 1/size x sum(Y[m] g(w - 2pi m / size))
+//	g(w) = exp(-w^2 / 4tau)     : SCAN_SPREAD bins on each side
+//
+// plan is cached for each (rate, length), and keeps twiddle table.
+// Note: it is not thread safe.
+//
+struct plan {
+	struct plan *next;
+
+	int rate;
+	int length;	// analyze length
+	int size;	// FFT size (2^n, >= length * 2)
+	int crossover;	// number of frequency (0 : not yet measured)
+
+	int    *rev;	// bit reverse	(size / 2)
+	double *tw_re;	// twiddle	(size / 2)
+	double *tw_im;
+	double *re;	// work		(size / 2 + 1)
+	double *im;
+	double *in;	// FFT input	(size)
+
+	double	tau;	// Gaussian
+	double *deconv;	// 1 / g^(k)	(length)
+	double *gauss;	// g(l bin)	(SCAN_SPREAD + 1)
+};
+
+static struct plan *plan_list = NULL;
+
+#define SCAN_MAX	64
+#define SCAN_SPREAD	12	// Gaussian width (bin), error ~ 1e-12
+#define SCAN_TIMING	3	// measure crossover (best of)
+
+//=======================================
+//
+// fft
+//
+// size/2 points complex FFT (radix-2, in-place)
+//
+//=======================================
+static void fft(struct plan *plan, double *re, double *im)
+{
+	int n = plan->size / 2;
+	int i, j, k, len;
+
+	for (i = 0; i < n; i++) {
+		j = plan->rev[i];
+		if (i < j) {
+			double t;
+
+			t = re[i]; re[i] = re[j]; re[j] = t;
+			t = im[i]; im[i] = im[j]; im[j] = t;
+		}
+	}
+
+	for (len = 2; len <= n; len <<= 1) {
+		// twiddle for len is every (size / len) on size table
+		int step = plan->size / len;
+
+		for (i = 0; i < n; i += len) {
+			for (k = 0; k < len / 2; k++) {
+				double wr = plan->tw_re[k * step];
+				double wi = plan->tw_im[k * step];
+				int a = i + k;
+				int b = i + k + len / 2;
+				double xr = re[b] * wr - im[b] * wi;
+				double xi = re[b] * wi + im[b] * wr;
+
+				re[b] = re[a] - xr;
+				im[b] = im[a] - xi;
+				re[a] += xr;
+				im[a] += xi;
+			}
+		}
+	}
+}
+
+//=======================================
+//
+// fft_real
+//
+// real input FFT by size/2 complex FFT
+//
+//	re[k], im[k] = X[k] (0 <= k <= size/2)
+//
+//=======================================
+static void fft_real(struct plan *plan, const double *in)
+{
+	int n = plan->size / 2;
+	double *re = plan->re;
+	double *im = plan->im;
+	int i;
+
+	// pack even/odd sample into complex
+	for (i = 0; i < n; i++) {
+		re[i] = in[2 * i];
+		im[i] = in[2 * i + 1];
+	}
+
+	fft(plan, re, im);
+
+	//==========================
+	// split
+	//
+	// X[k] = (Z[k] + Z*[n-k]) / 2 - j W^k (Z[k] - Z*[n-k]) / 2
+	//==========================
+	re[n] = re[0] - im[0];
+	im[n] = 0;
+	re[0] = re[0] + im[0];
+	im[0] = 0;
+
+	for (i = 1; i <= n / 2; i++) {
+		int j = n - i;
+		double er = (re[i] + re[j]) / 2;
+		double ei = (im[i] - im[j]) / 2;
+		double or = (im[i] + im[j]) / 2;
+		double oi = (re[j] - re[i]) / 2;
+		double wr = plan->tw_re[i];
+		double wi = plan->tw_im[i];
+		double tr = or * wr - oi * wi;
+		double ti = or * wi + oi * wr;
+
+		re[i] = er + tr;
+		im[i] = ei + ti;
+		re[j] = er - tr;
+		im[j] = ti - ei;
+	}
+}
+
+//=======================================
+//
+// scan_goertzel
+// scan_fft
+//
+// level of each fq[] (same scale as Goertzel)
+//
+//=======================================
+static void scan_goertzel(s16 *buf, int length, int rate, const int *fq, int nr,
+			  double *level)
+{
+	for (int i = 0; i < nr; i++)
+		level[i] = dtmf_goertzel(buf, length, rate, fq[i]);
+}
+
+static void scan_fft(struct plan *plan, s16 *buf, const int *fq, int nr, double *level)
+{
+	double h = PI2 / plan->size;
+	int n = plan->size / 2;
+	int c = plan->length / 2;
+	int i, l;
+
+	// deconvolve, and wrap around (k < 0 is on tail)
+	memset(plan->in, 0, plan->size * sizeof(double));
+	for (i = 0; i < plan->length; i++)
+		plan->in[(i - c + plan->size) % plan->size] = buf[i] * plan->deconv[i];
+
+	fft_real(plan, plan->in);
+
+	//==========================
+	// Gaussian gridding
+	//
+	// g(d - l h) = exp(-d^2 / 4tau) x exp(d h / 2tau)^l x exp(-(l h)^2 / 4tau)
+	//==========================
+	for (i = 0; i < nr; i++) {
+		double w  = fmod(PI2 * fq[i] / plan->rate, PI2);
+		int    m0 = w / h;
+		double d  = w - m0 * h;
+		double e1 = exp(-d * d / (4 * plan->tau));
+		double e2 = exp(d * h / (2 * plan->tau));
+		double el = pow(e2, 1 - SCAN_SPREAD);
+		double sr = 0;
+		double si = 0;
+
+		for (l = 1 - SCAN_SPREAD; l <= SCAN_SPREAD; l++, el *= e2) {
+			double g = e1 * el * plan->gauss[abs(l)];
+			int m = (m0 + l + plan->size) % plan->size;
+
+			// X[size - m] = X*[m]
+			if (m <= n) {
+				sr += g * plan->re[m];
+				si += g * plan->im[m];
+			} else {
+				sr += g * plan->re[plan->size - m];
+				si -= g * plan->im[plan->size - m];
+			}
+		}
+
+		level[i] = sqrt(sr * sr + si * si) / plan->size / (plan->length / 2.0);
+	}
+}
+
+//=======================================
+//
+// plan_crossover
+//
+// measure Goertzel for 1 frequency, and FFT for nr frequency on
+// 1st data. FFT cost doesn't depend on nr so much.
+//
+//=======================================
+static void plan_crossover(struct plan *plan, s16 *buf, const int *fq, int nr,
+			   double *level)
+{
+	double goertzel = 0;
+	double fft = 0;
+	double t;
+
+	for (int i = 0; i < SCAN_TIMING; i++) {
+		t = prof_now();
+		scan_goertzel(buf, plan->length, plan->rate, fq, 1, level);
+		t = prof_now() - t;
+		if (!i || t < goertzel)
+			goertzel = t;
+
+		t = prof_now();
+		scan_fft(plan, buf, fq, nr, level);
+		t = prof_now() - t;
+		if (!i || t < fft)
+			fft = t;
+	}
+
+	plan->crossover = (goertzel > 0) ? ceil(fft / goertzel) : SCAN_MAX + 1;
+	if (plan->crossover < 1)
+		plan->crossover = 1;
+}
+
+//=======================================
+//
+// plan_get
+//
+//=======================================
+static struct plan *plan_get(int rate, int length)
+{
+	struct plan *plan;
+	double r;
+	int n, i, bits;
+
+	for (plan = plan_list; plan; plan = plan->next)
+		if (plan->rate   == rate &&
+		    plan->length == length)
+			return plan;
+
+	plan = calloc(1, sizeof(*plan));
+	if (!plan)
+		return NULL;
+
+	plan->rate	= rate;
+	plan->length	= length;
+
+	// 2x over sampling for gridding
+	for (plan->size = 4; plan->size < length * 2; plan->size <<= 1)
+		;
+
+	n = plan->size / 2;
+	plan->rev	= calloc(n,	sizeof(int));
+	plan->tw_re	= calloc(n,	sizeof(double));
+	plan->tw_im	= calloc(n,	sizeof(double));
+	plan->re	= calloc(n + 1, sizeof(double));
+	plan->im	= calloc(n + 1, sizeof(double));
+	plan->in	= calloc(plan->size, sizeof(double));
+	plan->deconv	= calloc(length, sizeof(double));
+	plan->gauss	= calloc(SCAN_SPREAD + 1, sizeof(double));
+	if (!plan->rev || !plan->tw_re || !plan->tw_im || !plan->re || !plan->im ||
+	    !plan->in  || !plan->deconv || !plan->gauss)
+		goto err;
+
+	for (bits = 0; (1 << bits) < n; bits++)
+		;
+	for (i = 0; i < n; i++) {
+		int r = 0;
+
+		for (int b = 0; b < bits; b++)
+			if (i & (1 << b))
+				r |= 1 << (bits - 1 - b);
+		plan->rev[i] = r;
+	}
+
+	// W^k = exp(-j 2 pi k / size)
+	for (i = 0; i < n; i++) {
+		plan->tw_re[i] =  cos(PI2 * i / plan->size);
+		plan->tw_im[i] = -sin(PI2 * i / plan->size);
+	}
+
+	//==========================
+	// Gaussian
+	//
+	// tau = pi x SPREAD / (length^2 x R (R - 0.5))	(R = size / length)
+	// g^(k) = sqrt(tau / pi) exp(-k^2 tau)
+	//==========================
+	r = (double)plan->size / length;
+	plan->tau = M_PI * SCAN_SPREAD / ((double)length * length * r * (r - 0.5));
+
+	for (i = 0; i < length; i++) {
+		double k = i - length / 2;
+
+		plan->deconv[i] = sqrt(M_PI / plan->tau) * exp(k * k * plan->tau);
+	}
+	for (i = 0; i <= SCAN_SPREAD; i++) {
+		double d = PI2 / plan->size * i;
+
+		plan->gauss[i] = exp(-d * d / (4 * plan->tau));
+	}
+
+	plan->next = plan_list;
+	plan_list  = plan;
+
+	return plan;
+err:
+	free(plan->rev);
+	free(plan->tw_re);
+	free(plan->tw_im);
+	free(plan->re);
+	free(plan->im);
+	free(plan->in);
+	free(plan->deconv);
+	free(plan->gauss);
+	free(plan);
+
+	return NULL;
+}
+
+//=======================================
+//
+// dtmf_scan
+//
+// level of each fq[] (same scale as Goertzel)
+//
+// return 1 if it used FFT
+//
+//=======================================
+int dtmf_scan(s16 *buf, int length, int rate, const int *fq, int nr, double *level)
+{
+	struct plan *plan = plan_get(rate, length);
+
+	if (plan && !plan->crossover)
+		plan_crossover(plan, buf, fq, nr, level);
+
+	if (!plan || nr < plan->crossover) {
+		scan_goertzel(buf, length, rate, fq, nr, level);
+		return 0;
+	}
+
+	scan_fft(plan, buf, fq, nr, level);
+
+	return 1;
+}
+
+//=======================================
+//
+// dtmf_scan_analyze
+//
+// print each frequency average level on each channels
+//
+//	> simple_dtmf -f 697,1209,2418 -i 11.wav
+//	ch0  697Hz 9132.7 1209Hz 5269.1 2418Hz 12.6
+//
+//=======================================
+int dtmf_scan_analyze(struct dev_param *param)
+{
+	double level[SCAN_MAX];
+	double *sum;
+	int fq[SCAN_MAX];
+	char *str = param->scan;
+	char *end;
+	int nr = 0;
+	int width;
+	int challenge;
+	int fft_used = 0;
+	int ret = -EINVAL;
+	int i, j, k;
+
+	//==========================
+	// frequency list
+	//
+	// ex) 697,1209,2418
+	//==========================
+	while (*str) {
+		if (nr == SCAN_MAX)
+			goto err;
+
+		fq[nr] = strtol(str, &end, 10);
+		if (end == str || fq[nr] <= 0)
+			goto err;
+		nr++;
+
+		str = end;
+		if (*str == ',')
+			str++;
+		else if (*str)
+			goto err;
+	}
+	if (!nr)
+		goto err;
+
+	ret = wav_read_header(param);
+	if (ret < 0)
+		goto err;
+
+	width		= param->rate / 100 * DEGREE;
+	challenge	= param->length / width;
+
+	ret = -ENOMEM;
+	sum = calloc(nr, sizeof(double));
+	if (!sum)
+		goto err;
+
+	param->buf = calloc(param->length, param->sample);
+	if (!param->buf)
+		goto free;
+
+	for (i = 0; i < param->chan; i++) {
+		memset(sum, 0, nr * sizeof(double));
+
+		ret = wav_read_data(param, i);
+		if (ret < 0)
+			goto free;
+
+		for (j = 0; j < challenge; j++) {
+			fft_used = dtmf_scan(param->buf + width * j, width, param->rate,
+					     fq, nr, level);
+
+			for (k = 0; k < nr; k++)
+				sum[k] += level[k];
+		}
+
+		printf("ch%-2d", i);
+		for (k = 0; k < nr; k++)
+			printf(" %dHz %.1f", fq[k], challenge ? sum[k] / challenge : 0);
+		printf("\n");
+	}
+
+	if (param->flag & FLAG_VERBOSE) {
+		struct plan *plan = plan_get(param->rate, width);
+
+		printf("engine  : %s (crossover %d)\n",
+		       fft_used ? "FFT" : "Goertzel",
+		       plan ? plan->crossover : 0);
+	}
+
+	// success
+	ret = 0;
+free:
+	free(param->buf);
+	param->buf = NULL;
+	free(sum);
+err:
+	return ret;
+}
@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: GPLv2
+//
+// shm.c
+//
+// Copyright (c) 2026 agent <agent@local>
+//
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "param.h"
+#include "shm.h"
+
+//=================================================
+//
+//
+//		defines
+//
+//
+//=================================================
+#define SHM_POLL_NSEC	1000000	// 1ms
+
+//=======================================
+//
+// shm_attach
+//
+//=======================================
+static struct shm *shm_attach(struct dev_param *param, size_t *size)
+{
+	struct shm *shm;
+	struct stat st;
+	int fd;
+
+	fd = shm_open(param->filename, O_RDWR, 0);
+	if (fd < 0)
+		return NULL;
+
+	if (fstat(fd, &st) < 0 ||
+	    st.st_size < sizeof(struct shm))
+		goto err;
+
+	shm = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (shm == MAP_FAILED)
+		goto err;
+
+	close(fd);
+
+	*size = st.st_size;
+
+	return shm;
+err:
+	close(fd);
+
+	return NULL;
+}
+
+//=======================================
+//
+// dtmf_shm_analyze
+//
+// It analyzes each challenge (= width frames) when it became available,
+// and prints the result when it was decided.
+// Data is not copied, it is analyzed on the shared pages directly.
+// Wrapped challenge uses 2 segments.
+//
+//	       <-- seg[1] -->          <- seg[0] ->
+//	data = [yyyyyyyyyyyyy_______...xxxxxxxxxxxx]
+//	                               ^
+//	                               tail % frames
+//
+//=======================================
+int dtmf_shm_analyze(struct dev_param *param)
+{
+	struct timespec poll = { 0, SHM_POLL_NSEC };
+	struct dtmf_decoder dec;
+	struct dtmf_level lv;
+	struct shm *shm;
+	uint64_t head, tail;
+	size_t size;
+	int width;
+	int ret = -ENOENT;
+
+	shm = shm_attach(param, &size);
+	if (!shm)
+		goto err;
+
+	//==========================
+	// check header
+	//==========================
+	ret = -EINVAL;
+	if (shm->magic   != SHM_MAGIC	||
+	    shm->version != SHM_VERSION	||
+	    shm->chan	 == 0		||
+	    shm->chan	 >  MAX_CHAN	||
+	    shm->rate	 == 0		||
+	    shm->frames	 == 0		||
+	    size < sizeof(*shm) + (size_t)shm->frames * shm->chan * sizeof(s16))
+		goto unmap;
+
+	param->rate	= shm->rate;
+	param->chan	= shm->chan;
+	param->sample	= sizeof(s16);
+	width		= param->rate / 100 * DEGREE;
+
+	// rate < 100 has no challenge
+	if (width <= 0 || width > shm->frames)
+		goto unmap;
+
+	if (param->flag & FLAG_VERBOSE) {
+		printf("chan    : %d\n", param->chan);
+		printf("rate    : %d\n", param->rate);
+		printf("bit     : %d\n", param->sample * 8);
+		printf("frames  : %d\n", shm->frames);
+	}
+
+	// print result directly
+	dtmf_decoder_init(&dec, param->chan, NULL, 0);
+
+	tail = atomic_load_explicit(&shm->tail, memory_order_relaxed);
+	while (1) {
+		struct dtmf_data data;
+		char col[MAX_CHAN];
+		int pos, seg;
+
+		head = atomic_load_explicit(&shm->head, memory_order_acquire);
+		if (head - tail < width) {
+			// check EOF after head, producer sets it after last head
+			if (atomic_load_explicit(&shm->flags, memory_order_acquire) & SHM_FLAG_EOF &&
+			    atomic_load_explicit(&shm->head,  memory_order_acquire) == head)
+				break;
+
+			nanosleep(&poll, NULL);
+			continue;
+		}
+
+		//==========================
+		// analyze 1 challenge on each channels
+		//==========================
+		pos = tail % shm->frames;
+		seg = shm->frames - pos;
+		if (seg > width)
+			seg = width;
+
+		prof_start(PROF_COMPUTE);
+		for (int i = 0; i < param->chan; i++) {
+			data.buf[0]	= shm->data + (pos * param->chan) + i;
+			data.length[0]	= seg;
+			data.buf[1]	= shm->data + i;
+			data.length[1]	= width - seg;
+			data.stride	= param->chan;
+
+			col[i] = dtmf_analyze_data(&data, param->rate, &lv);
+		}
+		prof_stop(PROF_COMPUTE);
+		prof_add(PROF_ANALYZED, param->chan);
+		prof_add(PROF_SAMPLES,  param->chan * width);
+
+		if (param->flag & FLAG_VERBOSE) {
+			for (int i = 0; i < param->chan; i++)
+				printf("%c", col[i]);
+			printf("\n");
+		}
+
+		// release the frames to producer
+		tail += width;
+		atomic_store_explicit(&shm->tail, tail, memory_order_release);
+
+		prof_start(PROF_DECIDE);
+		dtmf_decoder_push(&dec, col);
+		prof_stop(PROF_DECIDE);
+	}
+
+	dtmf_decoder_finish(&dec);
+	printf("\n");
+
+	// success
+	ret = 0;
+unmap:
+	munmap(shm, size);
+err:
+	return ret;
+}
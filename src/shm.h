@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: GPLv2
+ *
+ * shm.h
+ *
+ * Copyright (c) 2026 agent <agent@local>
+ */
+#ifndef __SHM_H
+#define __SHM_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+/*
+ * POSIX shared memory ring buffer for -s
+ *
+ * single producer (capture process) / single consumer (simple_dtmf)
+ *
+ *	+--------------+
+ *	| struct shm   |
+ *	+--------------+ <- data
+ *	| frame 0      |  [ch0][ch1]...[chN] (S16_LE, interleaved)
+ *	| frame 1      |
+ *	| ...          |
+ *	| frame N-1    |
+ *	+--------------+
+ *
+ * head/tail are total frames count, and never wrap.
+ * data position is (head % frames).
+ *
+ * producer
+ *	1) fill header (magic is the last), ftruncate() it
+ *	2) write frames to data[], and then, increase head (release)
+ *	   it should not overtake tail + frames
+ *	3) set SHM_FLAG_EOF to flags when finished
+ *
+ * consumer
+ *	1) read head (acquire), analyze data[] directly
+ *	2) increase tail (release)
+ */
+#define SHM_MAGIC	0x464d5444	/* "DTMF" */
+#define SHM_VERSION	1
+
+#define SHM_FLAG_EOF	(1 << 0)
+
+struct shm {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t rate;
+	uint32_t chan;
+	uint32_t frames;		/* ring size */
+	_Atomic uint32_t flags;
+	uint32_t reserved[2];
+
+	/* separate cache line for producer/consumer */
+	_Alignas(64) _Atomic uint64_t head;	/* producer */
+	_Alignas(64) _Atomic uint64_t tail;	/* consumer */
+
+	_Alignas(64) int16_t data[];
+};
+
+#endif /* __SHM_H */
@@ -0,0 +1,429 @@
+// SPDX-License-Identifier: GPLv2
+//
+// sim.c
+//
+// Copyright (c) 2026 agent <agent@local>
+//
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "param.h"
+
+//=================================================
+//
+//
+//		defines
+//
+//
+//=================================================
+//
+// in-process loopback simulation
+//
+//	dtmf_fill() -> channel model -> dtmf_analyze() -> check
+//
+//	+--------+	delay, gain, dc, noise,
+//	| chan 0 |--+	clip, resample, remap	+--------+
+//	| chan 1 |--+-------------------------->| chan x |
+//	| ...    |				| ...    |
+//	+--------+				+--------+
+//
+struct sim {
+	int	cases;
+	int	threads;
+	int	msec;		// signal length
+	int	delay;		// samples
+	double	gain;		// dB
+	double	snr;		// dB
+	int	noise;		// snr was indicated
+	double	dc;
+	int	clip;
+	int	resample;	// rate after channel, 0 = no resample
+	int	map[MAX_CHAN];	// out chan <- in chan
+	unsigned int seed;
+
+	s16	*tone[10];	// dtmf_fill() result of '0' - '9'
+	int	length;
+
+	int	rate;
+	int	chan;
+	int	verbose;
+
+	pthread_mutex_t lock;
+};
+
+struct sim_thread {
+	pthread_t	 thread;
+	struct sim	*sim;
+	int		 id;
+	long		 pass;
+	long		 fail;
+};
+
+enum {
+	SIM_CASES,
+	SIM_THREADS,
+	SIM_MSEC,
+	SIM_DELAY,
+	SIM_GAIN,
+	SIM_SNR,
+	SIM_DC,
+	SIM_CLIP,
+	SIM_RESAMPLE,
+	SIM_MAP,
+	SIM_SEED,
+};
+
+static const char *sim_token[] = {
+	[SIM_CASES]	= "n",
+	[SIM_THREADS]	= "threads",
+	[SIM_MSEC]	= "msec",
+	[SIM_DELAY]	= "delay",
+	[SIM_GAIN]	= "gain",
+	[SIM_SNR]	= "snr",
+	[SIM_DC]	= "dc",
+	[SIM_CLIP]	= "clip",
+	[SIM_RESAMPLE]	= "resample",
+	[SIM_MAP]	= "map",
+	[SIM_SEED]	= "seed",
+};
+
+//=======================================
+//
+// sim_rand
+// sim_gauss
+//
+// each case has own random sequence, thus the result is
+// same regardless of the number of threads.
+// bench.c uses it, too.
+//
+//=======================================
+unsigned int sim_rand(unsigned int *state)
+{
+	// xorshift32
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+
+	return *state;
+}
+
+double sim_gauss(unsigned int *state)
+{
+	double u1 = (sim_rand(state) + 1.0) / 4294967297.0;
+	double u2 = (sim_rand(state) + 1.0) / 4294967297.0;
+
+	return sqrt(-2 * log(u1)) * cos(PI2 * u2);
+}
+
+//=======================================
+//
+// sim_parse
+//
+//=======================================
+static int sim_parse(struct sim *sim, struct dev_param *param)
+{
+	char *opt = param->sim;
+	char *save;
+	char *val;
+	int i;
+
+	memset(sim, 0, sizeof(*sim));
+
+	// default settings
+	sim->cases	= 1000;
+	sim->threads	= sysconf(_SC_NPROCESSORS_ONLN);
+	sim->msec	= 1000;
+	sim->seed	= 1;
+	sim->rate	= param->rate;
+	sim->chan	= param->chan;
+	sim->verbose	= !!(param->flag & FLAG_VERBOSE);
+	for (i = 0; i < MAX_CHAN; i++)
+		sim->map[i] = i;
+
+	// ex) n=1000,snr=20,map=1032
+	for (opt = strtok_r(opt, ",", &save); opt; opt = strtok_r(NULL, ",", &save)) {
+		int token;
+
+		val = strchr(opt, '=');
+		if (val)
+			*val++ = '\0';
+
+		for (token = 0; token < ARRAY_SIZE(sim_token); token++)
+			if (!strcmp(opt, sim_token[token]))
+				break;
+
+		switch (token) {
+		case SIM_CASES:		if (!val) goto err; sim->cases		= atoi(val); break;
+		case SIM_THREADS:	if (!val) goto err; sim->threads	= atoi(val); break;
+		case SIM_MSEC:		if (!val) goto err; sim->msec		= atoi(val); break;
+		case SIM_DELAY:		if (!val) goto err; sim->delay		= atoi(val); break;
+		case SIM_GAIN:		if (!val) goto err; sim->gain		= atof(val); break;
+		case SIM_DC:		if (!val) goto err; sim->dc		= atof(val); break;
+		case SIM_CLIP:		if (!val) goto err; sim->clip		= atoi(val); break;
+		case SIM_RESAMPLE:	if (!val) goto err; sim->resample	= atoi(val); break;
+		case SIM_SEED:		if (!val) goto err; sim->seed		= atoi(val); break;
+		case SIM_SNR:
+			if (!val)
+				goto err;
+			sim->snr	= atof(val);
+			sim->noise	= 1;
+			break;
+		case SIM_MAP:
+			// ex) map=1032 : out 0 <- in 1, out 1 <- in 0, ...
+			if (!val || strlen(val) != sim->chan)
+				goto err;
+			for (i = 0; i < sim->chan; i++) {
+				if (sscanf(val + i, "%1x", &sim->map[i]) != 1 ||
+				    sim->map[i] >= sim->chan)
+					goto err;
+			}
+			break;
+		default:
+			goto err;
+		}
+	}
+
+	if (sim->cases	 <= 0 ||
+	    sim->threads <= 0 ||
+	    sim->msec	 <= 0 ||
+	    sim->delay	 <  0 ||
+	    sim->clip	 <  0 ||
+	    sim->resample < 0 ||
+	    !sim->seed)
+		goto err;
+
+	return 0;
+err:
+	return -EINVAL;
+}
+
+//=======================================
+//
+// sim_channel
+//
+// apply channel model to 1ch
+//
+//=======================================
+static void sim_channel(struct sim *sim, unsigned int *state,
+			s16 *in, int length, double *tmp, s16 *out, int out_length)
+{
+	double gain = pow(10, sim->gain / 20);
+	double power = 0;
+	double sigma = 0;
+	double v;
+	int i;
+
+	// delay, gain
+	for (i = 0; i < length; i++) {
+		tmp[i] = (i < sim->delay) ? 0 : in[i - sim->delay] * gain;
+		power += tmp[i] * tmp[i];
+	}
+
+	// noise is based on signal power
+	if (sim->noise)
+		sigma = sqrt(power / length / pow(10, sim->snr / 10));
+
+	for (i = 0; i < out_length; i++) {
+		// resample (linear interpolation)
+		if (sim->resample) {
+			double pos = (double)i * sim->rate / sim->resample;
+			int p = pos;
+
+			v = tmp[p];
+			if (p + 1 < length)
+				v += (tmp[p + 1] - tmp[p]) * (pos - p);
+		} else {
+			v = tmp[i];
+		}
+
+		v += sim->dc;
+		if (sigma > 0)
+			v += sim_gauss(state) * sigma;
+
+		if (sim->clip) {
+			if (v >  sim->clip) v =  sim->clip;
+			if (v < -sim->clip) v = -sim->clip;
+		}
+
+		if (v >  32767) v =  32767;
+		if (v < -32768) v = -32768;
+
+		out[i] = v;
+	}
+}
+
+//=======================================
+//
+// sim_thread
+//
+//=======================================
+static void *sim_thread(void *data)
+{
+	struct sim_thread *th = data;
+	struct sim *sim = th->sim;
+	struct dtmf_decoder dec;
+	int length	= sim->length;
+	int rate	= sim->resample ? sim->resample : sim->rate;
+	int out_length	= (long)length * rate / sim->rate;
+	int width	= rate / 100 * DEGREE;
+	int challenge	= out_length / width;
+	int size	= (challenge + 1) * (sim->chan + 1);
+	char num[MAX_CHAN];
+	char expect[MAX_CHAN + 1];
+	s16 *in[MAX_CHAN];
+	s16 *out;
+	double *tmp;
+	char *res, *str;
+	int i, j, c;
+
+	out = calloc(out_length, sizeof(*out));
+	tmp = calloc(length, sizeof(*tmp));
+	res = calloc(challenge * sim->chan, 1);
+	str = calloc(size, 1);
+	if (!out || !tmp || !res || !str)
+		goto err;
+
+	for (c = th->id; c < sim->cases; c += sim->threads) {
+		unsigned int state = sim->seed + c * 2654435761u;
+
+		if (!state)
+			state = 1;
+
+		//==========================
+		// generate
+		//==========================
+		for (i = 0; i < sim->chan; i++) {
+			num[i] = '0' + sim_rand(&state) % 10;
+			in[i]  = sim->tone[num[i] - '0'];
+		}
+
+		//==========================
+		// channel model and analyze
+		//==========================
+		for (i = 0; i < sim->chan; i++) {
+			sim_channel(sim, &state, in[sim->map[i]], length,
+				    tmp, out, out_length);
+
+			for (j = 0; j < challenge; j++)
+				res[challenge * i + j] = dtmf_analyze(out + width * j, width, rate);
+
+			expect[i] = num[sim->map[i]];
+		}
+		expect[sim->chan] = '\0';
+
+		//==========================
+		// decide
+		//==========================
+		dtmf_decoder_init(&dec, sim->chan, str, size);
+		for (j = 0; j < challenge; j++) {
+			char col[MAX_CHAN];
+
+			for (i = 0; i < sim->chan; i++)
+				col[i] = res[challenge * i + j];
+
+			dtmf_decoder_push(&dec, col);
+		}
+		dtmf_decoder_finish(&dec);
+
+		// decoder prints leading "," if 1st col was noise
+		if (!strcmp(expect, str + (str[0] == ','))) {
+			th->pass++;
+			continue;
+		}
+
+		th->fail++;
+		if (sim->verbose) {
+			pthread_mutex_lock(&sim->lock);
+			printf("case %d : expect:%s - got:%s : NG\n", c, expect, str);
+			pthread_mutex_unlock(&sim->lock);
+		}
+	}
+err:
+	free(out);
+	free(tmp);
+	free(res);
+	free(str);
+
+	return NULL;
+}
+
+//=======================================
+//
+// dtmf_sim
+//
+//=======================================
+int dtmf_sim(struct dev_param *param)
+{
+	struct sim_thread *th;
+	struct sim sim;
+	struct timespec start, end;
+	long pass = 0;
+	long fail = 0;
+	double sec;
+	int ret;
+	int i;
+
+	ret = sim_parse(&sim, param);
+	if (ret < 0)
+		goto err;
+
+	//==========================
+	// dtmf_fill() is same for each cases.
+	// create it for all nums in advance.
+	//==========================
+	ret = -ENOMEM;
+	sim.length = sim.rate * sim.msec / 1000;
+	for (i = 0; i < ARRAY_SIZE(sim.tone); i++) {
+		sim.tone[i] = calloc(sim.length, sizeof(s16));
+		if (!sim.tone[i])
+			goto free;
+
+		dtmf_fill(sim.tone[i], sim.length, sim.rate, sizeof(s16), '0' + i);
+	}
+
+	th = calloc(sim.threads, sizeof(*th));
+	if (!th)
+		goto free;
+
+	pthread_mutex_init(&sim.lock, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (i = 0; i < sim.threads; i++) {
+		th[i].sim = &sim;
+		th[i].id  = i;
+		if (pthread_create(&th[i].thread, NULL, sim_thread, th + i))
+			break;
+	}
+	// if pthread_create() failed, other threads will not
+	// handle its cases. count it as fail.
+	for (int j = i; j < sim.threads; j++)
+		for (int c = j; c < sim.cases; c += sim.threads)
+			th[j].fail++;
+
+	for (int j = 0; j < i; j++)
+		pthread_join(th[j].thread, NULL);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	pthread_mutex_destroy(&sim.lock);
+
+	for (i = 0; i < sim.threads; i++) {
+		pass += th[i].pass;
+		fail += th[i].fail;
+	}
+	free(th);
+
+	sec = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1000000000.0;
+
+	printf("cases   : %d\n", sim.cases);
+	printf("pass    : %ld\n", pass);
+	printf("fail    : %ld\n", fail);
+	printf("speed   : %.0f cases/sec (%d threads)\n", sim.cases / sec, sim.threads);
+
+	// missing case (= thread alloc failed) is fail
+	ret = (pass == sim.cases) ? 0 : 1;
+free:
+	for (i = 0; i < ARRAY_SIZE(sim.tone); i++)
+		free(sim.tone[i]);
+err:
+	return ret;
+}
@@ -30,6 +30,8 @@ struct wav {
 	u32  SubChunckSize;		// 4: file size - 44
 };
 
+_Static_assert(sizeof(struct wav) == WAV_HEADER, "wav header size");
+
 const static char *riff	= "RIFF";
 const static char *wave = "WAVE";
 const static char *fmt	= "fmt ";
@@ -41,7 +43,7 @@ const static char *data	= "data";
 // name_fill
 //
 //=======================================
-#define name_check(pos, ans) strncmp(pos, ans, ID_SIZE);
+#define name_check(pos, ans) strncmp(pos, ans, ID_SIZE)
 #define name_fill(pos, ans)   memcpy(pos, ans, ID_SIZE)
 
 //=======================================
@@ -146,31 +148,24 @@ no_open:
 
 //=======================================
 //
-// wav_read_header
+// wav_parse_header
+//
+// check header on memory, and fill params
 //
 //=======================================
-int wav_read_header(struct dev_param *param)
+int wav_parse_header(struct dev_param *param, const void *buf, int len)
 {
 	struct wav wav;
-	FILE *fp;
 	int rate;
 	int chan;
 	int sample;
-	int ret = -ENOENT;
+	int ret = -EIO;
 
-	//==========================
-	// file open
-	//==========================
-	if (!(fp = fopen(param->filename, "r")))
-		goto no_open;
-
-	//==========================
-	// read header part
-	//==========================
-	ret = -EIO;
-	if (!fread(&wav, sizeof(struct wav), 1, fp))
+	if (len < sizeof(struct wav))
 		goto err;
 
+	memcpy(&wav, buf, sizeof(struct wav));
+
 	chan	= wav.nChannels;
 	rate	= wav.nSamplesPerSec;
 	sample	= wav.wBitsPerSample / 8;
@@ -178,26 +173,16 @@ int wav_read_header(struct dev_param *param)
 	//==========================
 	// name part check
 	//==========================
-	ret = name_check(wav.riff, riff);
-	if (ret)
-		goto err;
-
-	ret = name_check(wav.ID, wave);
-	if (ret)
-		goto err;
-
-	ret = name_check(wav.ckID, fmt);
-	if (ret)
-		goto err;
-
-	ret = name_check(wav.SubChunck, data);
-	if (ret)
+	ret = -EINVAL;
+	if (name_check(wav.riff,	riff) ||
+	    name_check(wav.ID,		wave) ||
+	    name_check(wav.ckID,	fmt)  ||
+	    name_check(wav.SubChunck,	data))
 		goto err;
 
 	//==========================
 	// expectation part check
 	//==========================
-	ret = -EINVAL;
 	if (wav.cksize != 16)
 		goto err;
 	if (wav.wFormatTag != 0x0001) /* WAVE_FORMAT_PCM */
@@ -220,6 +205,39 @@ int wav_read_header(struct dev_param *param)
 	// success
 	ret = 0;
 err:
+	return ret;
+}
+
+//=======================================
+//
+// wav_read_header
+//
+//=======================================
+int wav_read_header(struct dev_param *param)
+{
+	struct wav wav;
+	FILE *fp;
+	int ret = -ENOENT;
+
+	//==========================
+	// file open
+	//==========================
+	if (!(fp = fopen(param->filename, "r")))
+		goto no_open;
+	prof_add(PROF_CALLS, 1);
+
+	//==========================
+	// read header part
+	//==========================
+	ret = -EIO;
+	prof_add(PROF_CALLS, 1);
+	if (!fread(&wav, sizeof(struct wav), 1, fp))
+		goto err;
+	prof_add(PROF_BYTES, sizeof(struct wav));
+
+	ret = wav_parse_header(param, &wav, sizeof(struct wav));
+err:
+	prof_add(PROF_CALLS, 1);
 	fclose(fp);
 no_open:
 	return ret;
@@ -241,12 +259,14 @@ int wav_read_data(struct dev_param *param, int chan)
 	//==========================
 	if (!(fp = fopen(param->filename, "r")))
 		goto no_open;
+	prof_add(PROF_CALLS, 1);
 
 	//==========================
 	// skip "header part" and
 	// 1st "non target channel" (offset)
 	//==========================
 	offset = chan * param->sample;
+	prof_add(PROF_CALLS, 1);
 	if (fseek(fp, sizeof(struct wav) + offset, SEEK_SET))
 		goto err;
 
@@ -264,10 +284,65 @@ int wav_read_data(struct dev_param *param, int chan)
 			goto err;
 	}
 
+	// 1 fread() (+ 1 fseek()) per sample
+	prof_add(PROF_BYTES, param->length * param->sample);
+	prof_add(PROF_CALLS, param->length * ((offset > 0) ? 2 : 1));
+
 	// success
 	ret = 0;
 err:
+	prof_add(PROF_CALLS, 1);
 	fclose(fp);
 no_open:
 	return ret;
 }
+
+//=======================================
+//
+// wav_open_data
+// wav_read_frames
+//
+// read interleaved frames from top of data.
+// Caller needs to fclose() fp
+//
+//=======================================
+int wav_open_data(struct dev_param *param, FILE **fp)
+{
+	int ret = -ENOENT;
+
+	//==========================
+	// file open
+	//==========================
+	if (!(*fp = fopen(param->filename, "r")))
+		goto no_open;
+	prof_add(PROF_CALLS, 1);
+
+	//==========================
+	// skip "header part"
+	//==========================
+	ret = -EIO;
+	prof_add(PROF_CALLS, 1);
+	if (fseek(*fp, sizeof(struct wav), SEEK_SET))
+		goto err;
+
+	// success
+	return 0;
+err:
+	fclose(*fp);
+	*fp = NULL;
+no_open:
+	return ret;
+}
+
+int wav_read_frames(struct dev_param *param, FILE *fp, s16 *buf, int frames)
+{
+	int size = param->sample * param->chan;
+
+	// 1 fread() per frames
+	prof_add(PROF_CALLS, 1);
+	if (fread(buf, size, frames, fp) != frames)
+		return -EINVAL;
+	prof_add(PROF_BYTES, frames * size);
+
+	return 0;
+}